@@ -51,6 +51,7 @@ fast_downward_plugin(
         abstract_task
         axioms
         command_line
+        concurrent_state_registry
         evaluation_context
         evaluation_result
         evaluator
@@ -122,6 +123,8 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/mpsc_queue
+        utils/parallel
         utils/rng
         utils/rng_options
         utils/strings
@@ -146,6 +149,13 @@ fast_downward_plugin(
         open_lists/best_first_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_OPEN_LIST
+    HELP "Open lists that store their buckets in arrays indexed by evaluator values"
+    SOURCES
+        open_lists/bucket_open_list
+)
+
 fast_downward_plugin(
     NAME EPSILON_GREEDY_OPEN_LIST
     HELP "Open list that chooses an entry randomly with probability epsilon"
@@ -190,6 +200,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME BLOCKED_BLOOM_FILTER
+    HELP "Probabilistic set of hash values"
+    SOURCES
+        algorithms/blocked_bloom_filter
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME EQUIVALENCE_RELATION
     HELP "Equivalence relation over [1, ..., n] that can be iteratively refined"
@@ -242,6 +260,7 @@ fast_downward_plugin(
     NAME SEGMENTED_VECTOR
     HELP "Memory-friendly and vector-like data structure"
     SOURCES
+        algorithms/segment_storage
         algorithms/segmented_vector
     DEPENDENCY_ONLY
 )
@@ -424,6 +443,31 @@ fast_downward_plugin(
     DEPENDS EAGER_SEARCH SEARCH_COMMON
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_EAGER_SEARCH
+    HELP "Hash-distributed parallel eager search algorithm"
+    SOURCES
+        search_engines/parallel_eager_search
+    DEPENDS SEARCH_COMMON SUCCESSOR_GENERATOR
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME PLUGIN_PARALLEL_ASTAR
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/plugin_parallel_astar
+    DEPENDS PARALLEL_EAGER_SEARCH
+)
+
+fast_downward_plugin(
+    NAME PLUGIN_PARALLEL_EAGER_GREEDY
+    HELP "Hash-distributed parallel eager greedy best-first search"
+    SOURCES
+        search_engines/plugin_parallel_eager_greedy
+    DEPENDS PARALLEL_EAGER_SEARCH
+)
+
 fast_downward_plugin(
     NAME PLUGIN_LAZY
     HELP "Best-first search with deferred evaluation (lazy)"
@@ -468,7 +512,7 @@ fast_downward_plugin(
     HELP "Lazy search algorithm"
     SOURCES
         search_engines/lazy_search
-    DEPENDS ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS BLOCKED_BLOOM_FILTER ORDERED_SET SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
 
@@ -487,7 +531,9 @@ fast_downward_plugin(
     HELP "The base class for relaxation heuristics"
     SOURCES
         heuristics/array_pool
+        heuristics/batch_relaxed_exploration
         heuristics/relaxation_heuristic
+    DEPENDS SCCS
     DEPENDENCY_ONLY
 )
 
@@ -560,6 +606,7 @@ fast_downward_plugin(
     SOURCES
         heuristics/lm_cut_heuristic
         heuristics/lm_cut_landmarks
+        heuristics/lm_cut_storage
     DEPENDS PRIORITY_QUEUES TASK_PROPERTIES
 )
 
@@ -707,11 +754,13 @@ fast_downward_plugin(
     NAME LANDMARKS
     HELP "Plugin containing the code to reason with landmarks"
     SOURCES
+        landmarks/dalm_compact_graph
         landmarks/dalm_graph
         landmarks/dalm_graph_factory
         landmarks/dalm_greedy_hitting_set_heuristic
         landmarks/dalm_heuristic
         landmarks/dalm_status_manager
+        landmarks/dalm_status_pool
         landmarks/dalm_sum_heuristic
         landmarks/exploration
         landmarks/fact_landmark_graph_translator_factory
@@ -742,11 +791,13 @@ fast_downward_plugin(
         landmarks/dalm_factory_reasonable_orders_hps
     	landmarks/dalm_factory_rhw
         landmarks/dalm_factory_uaa
+        landmarks/dalm_compact_graph
         landmarks/dalm_graph
         landmarks/dalm_graph_factory
         landmarks/dalm_greedy_hitting_set_heuristic
         landmarks/dalm_heuristic
         landmarks/dalm_status_manager
+        landmarks/dalm_status_pool
         landmarks/dalm_sum_heuristic
         landmarks/exploration
         landmarks/fact_landmark_graph_translator_factory
@@ -768,6 +819,7 @@ fast_downward_plugin(
         algorithms/floyd_warshall
         algorithms/johnson_cycle_detection
         landmarks/cycle_oracle
+        landmarks/cycle_pool
         landmarks/cyclic_landmark_heuristic
         landmarks/depth_first_oracle
         landmarks/floyd_warshall_oracle
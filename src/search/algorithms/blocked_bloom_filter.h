@@ -0,0 +1,100 @@
+#ifndef ALGORITHMS_BLOCKED_BLOOM_FILTER_H
+#define ALGORITHMS_BLOCKED_BLOOM_FILTER_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace blocked_bloom_filter {
+/*
+  Probabilistic set of 64-bit hash values (a split block Bloom filter).
+
+  The filter consists of blocks of eight 32-bit words. The upper half of
+  a hash value selects a block and the lower half sets (or tests) one bit
+  in each word of that block, so every operation touches a single block
+  within one cache line. may_contain never misses an inserted hash value,
+  but it can report hash values that were never inserted. With 16 bits
+  per inserted value, this happens for roughly 0.2% of the queries.
+
+  Hash values cannot be removed, and the number of blocks is fixed. To
+  grow the filter, clear it with more blocks and insert all values again.
+*/
+class BlockedBloomFilter {
+    static const int WORDS_PER_BLOCK = 8;
+
+    struct alignas(32) Block {
+        std::array<std::uint32_t, WORDS_PER_BLOCK> words;
+    };
+
+    std::vector<Block> blocks;
+    int num_values;
+
+    static Block compute_mask(std::uint32_t key) {
+        // Odd constants from the Parquet specification of split block filters.
+        static const std::uint32_t salts[WORDS_PER_BLOCK] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+        Block mask;
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+            mask.words[i] = std::uint32_t(1) << ((key * salts[i]) >> 27);
+        }
+        return mask;
+    }
+
+    std::size_t get_block_index(std::uint64_t hash) const {
+        return ((hash >> 32) * blocks.size()) >> 32;
+    }
+
+public:
+    explicit BlockedBloomFilter(std::size_t num_blocks) {
+        clear(num_blocks);
+    }
+
+    // Remove all values and use the given number of blocks from now on.
+    void clear(std::size_t num_blocks) {
+        assert(num_blocks > 0);
+        blocks.assign(num_blocks, Block());
+        num_values = 0;
+    }
+
+    void insert(std::uint64_t hash) {
+        Block &block = blocks[get_block_index(hash)];
+        Block mask = compute_mask(static_cast<std::uint32_t>(hash));
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+            block.words[i] |= mask.words[i];
+        }
+        ++num_values;
+    }
+
+    bool may_contain(std::uint64_t hash) const {
+        const Block &block = blocks[get_block_index(hash)];
+        Block mask = compute_mask(static_cast<std::uint32_t>(hash));
+        std::uint32_t missing_bits = 0;
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+            missing_bits |= mask.words[i] & ~block.words[i];
+        }
+        return missing_bits == 0;
+    }
+
+    // Number of insertions since the last call to clear.
+    int size() const {
+        return num_values;
+    }
+
+    std::size_t get_num_blocks() const {
+        return blocks.size();
+    }
+
+    std::size_t get_num_bits() const {
+        return blocks.size() * sizeof(Block) * 8;
+    }
+
+    std::size_t estimate_memory_in_bytes() const {
+        return blocks.size() * sizeof(Block);
+    }
+};
+}
+
+#endif
@@ -280,6 +280,10 @@ public:
         return num_entries;
     }
 
+    std::size_t estimate_memory_in_bytes() const {
+        return buckets.size() * sizeof(Bucket);
+    }
+
     /*
       Insert a key into the hash set.
 
@@ -292,6 +296,16 @@ public:
         return insert(key, hasher(key));
     }
 
+    /*
+      Return the key in the hash set that is equivalent to the given key,
+      or -1 if there is none. The given key does not have to be contained
+      in the hash set, but it must be hashable and comparable.
+    */
+    KeyType find(KeyType key) const {
+        assert(key >= 0);
+        return find_equal_key(key, hasher(key));
+    }
+
     void dump(utils::LogProxy &log) const {
         int num_buckets = capacity();
         log << "[";
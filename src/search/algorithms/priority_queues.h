@@ -4,6 +4,9 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -26,6 +29,9 @@
   function calls and do some additional inlining. The class has the
   same interface as AbstractQueue, however, to facilitate swapping the
   different implementations in and out.
+
+  RadixHeap is a separate, more specialized queue for algorithms that
+  never push a key smaller than the last popped key (see below).
  */
 namespace priority_queues {
 template<typename Value>
@@ -282,6 +288,86 @@ public:
         wrapped_queue->add_virtual_pushes(num_extra_pushes);
     }
 };
+
+/*
+  Monotone priority queue with non-negative integer keys: after popping
+  an entry with key k, only keys of at least k may be pushed until the
+  queue is cleared. This holds for Dijkstra-style explorations with
+  non-negative costs.
+
+  Entries are kept in 33 buckets. Bucket 0 holds the entries whose key
+  equals the last popped key and bucket i > 0 those whose key first
+  differs from it in bit i - 1. When bucket 0 runs empty, the entries of
+  the first non-empty bucket are redistributed with their minimum as the
+  new last popped key, which moves each entry at most 32 times in total.
+
+  Entries with equal keys are popped in reverse order of their pushes,
+  like in BucketQueue. Within a bucket, entries are ordered by the time
+  of their push, since a bucket only receives redistributed entries
+  while all lower buckets (and hence it) are empty.
+*/
+template<typename Value>
+class RadixHeap {
+    static const int NUM_BUCKETS = std::numeric_limits<unsigned int>::digits + 1;
+
+    using Entry = std::pair<int, Value>;
+    std::array<std::vector<Entry>, NUM_BUCKETS> buckets;
+    int last_key;
+    int num_entries;
+
+    int get_bucket_no(int key) const {
+        return std::bit_width(static_cast<unsigned int>(key ^ last_key));
+    }
+
+    void refill_first_bucket() {
+        int bucket_no = 1;
+        while (buckets[bucket_no].empty())
+            ++bucket_no;
+        std::vector<Entry> &bucket = buckets[bucket_no];
+        last_key = std::numeric_limits<int>::max();
+        for (const Entry &entry : bucket)
+            last_key = std::min(last_key, entry.first);
+        for (const Entry &entry : bucket) {
+            assert(get_bucket_no(entry.first) < bucket_no);
+            buckets[get_bucket_no(entry.first)].push_back(entry);
+        }
+        bucket.clear();
+    }
+
+public:
+    RadixHeap() : last_key(0), num_entries(0) {
+    }
+
+    void push(int key, const Value &value) {
+        assert(key >= last_key);
+        buckets[get_bucket_no(key)].emplace_back(key, value);
+        ++num_entries;
+    }
+
+    Entry pop() {
+        assert(num_entries > 0);
+        if (buckets[0].empty())
+            refill_first_bucket();
+        Entry result = buckets[0].back();
+        buckets[0].pop_back();
+        --num_entries;
+        return result;
+    }
+
+    bool empty() const {
+        return num_entries == 0;
+    }
+
+    // Remove all entries and allow pushing any key again.
+    void clear() {
+        if (num_entries != 0) {
+            for (std::vector<Entry> &bucket : buckets)
+                bucket.clear();
+            num_entries = 0;
+        }
+        last_key = 0;
+    }
+};
 }
 
 #endif
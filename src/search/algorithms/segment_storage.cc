@@ -0,0 +1,243 @@
+#include "segment_storage.h"
+
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace segmented_vector {
+/*
+  The storage is never destroyed because segmented vectors in static
+  objects may release their segments after other static objects have
+  been destroyed. The operating system cleans up the mapping and the file.
+*/
+static MappedSegmentStorage *mapped_segment_storage = nullptr;
+
+// Alignment of all segments (at least the size of a cache line).
+static const size_t SEGMENT_ALIGNMENT = 64;
+static const size_t MAX_REGION_SIZE = 64 * 1024 * 1024;
+static const size_t MIN_REGION_SIZE = 1024 * 1024;
+
+static size_t round_up(size_t num_bytes, size_t alignment) {
+    return (num_bytes + alignment - 1) / alignment * alignment;
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static size_t get_page_size() {
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+NO_RETURN static void exit_with_system_error(
+    const string &action, utils::ExitCode exit_code) {
+    cerr << "Mapped segment storage: failed to " << action << ": "
+         << strerror(errno) << endl;
+    utils::exit_with(exit_code);
+}
+
+static int create_unlinked_file(const string &directory) {
+    string path = directory + "/downward-states-XXXXXX";
+    vector<char> path_buffer(path.begin(), path.end());
+    path_buffer.push_back('\0');
+    int fd = mkstemp(path_buffer.data());
+    if (fd == -1) {
+        exit_with_system_error("create a file in " + directory,
+                               utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    /* Remove the directory entry right away, so that the file is deleted
+       when the planner exits, no matter how. */
+    unlink(path_buffer.data());
+    return fd;
+}
+
+MappedSegmentStorage::MappedSegmentStorage(
+    const string &directory, size_t memory_budget)
+    : fd(create_unlinked_file(directory)),
+      memory_budget(memory_budget),
+      region_size(round_up(
+                      clamp(memory_budget / 8, MIN_REGION_SIZE, MAX_REGION_SIZE),
+                      get_page_size())),
+      file_size(0),
+      next_free(nullptr),
+      region_end(nullptr),
+      clock_hand(0),
+      num_bytes_allocated(0),
+      num_page_outs(0) {
+}
+
+MappedSegmentStorage::~MappedSegmentStorage() {
+    for (const Region &region : regions) {
+        munmap(region.start, region.size);
+    }
+    close(fd);
+}
+
+MappedSegmentStorage::Region &MappedSegmentStorage::map_region(size_t num_bytes) {
+    size_t size = round_up(max(num_bytes, region_size), get_page_size());
+    if (ftruncate(fd, file_size + size) == -1) {
+        exit_with_system_error("grow the file",
+                               utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    void *start = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fd, file_size);
+    if (start == MAP_FAILED) {
+        exit_with_system_error("map the file",
+                               utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    regions.push_back({static_cast<char *>(start), size, file_size});
+    file_size += size;
+    enforce_memory_budget();
+    return regions.back();
+}
+
+size_t MappedSegmentStorage::get_resident_bytes(const Region &region) const {
+    size_t page_size = get_page_size();
+    size_t num_pages = region.size / page_size;
+#if OPERATING_SYSTEM == OSX
+    vector<char> page_is_resident(num_pages);
+#else
+    vector<unsigned char> page_is_resident(num_pages);
+#endif
+    if (mincore(region.start, region.size, page_is_resident.data()) == -1) {
+        // Assume the worst if residency is unknown.
+        return region.size;
+    }
+    size_t num_resident_pages = count_if(
+        page_is_resident.begin(), page_is_resident.end(),
+        [](auto flags) {return flags & 1;});
+    return num_resident_pages * page_size;
+}
+
+void MappedSegmentStorage::page_out(const Region &region) {
+    /* Write the dirty pages to the file and drop them from our address
+       space and from the page cache. */
+    msync(region.start, region.size, MS_SYNC);
+    madvise(region.start, region.size, MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(fd, region.file_offset, region.size, POSIX_FADV_DONTNEED);
+#endif
+    ++num_page_outs;
+}
+
+void MappedSegmentStorage::enforce_memory_budget() {
+    if (file_size <= memory_budget || regions.size() < 2) {
+        return;
+    }
+    size_t resident_bytes = 0;
+    for (const Region &region : regions) {
+        resident_bytes += get_resident_bytes(region);
+    }
+    // Never page out the newest region, which receives the next segments.
+    size_t num_candidates = regions.size() - 1;
+    for (size_t i = 0; i < num_candidates && resident_bytes > memory_budget; ++i) {
+        clock_hand %= num_candidates;
+        const Region &region = regions[clock_hand++];
+        size_t region_resident_bytes = get_resident_bytes(region);
+        if (region_resident_bytes > 0) {
+            page_out(region);
+            resident_bytes -= region_resident_bytes;
+        }
+    }
+}
+
+bool MappedSegmentStorage::is_mapped(const void *ptr) const {
+    const char *address = static_cast<const char *>(ptr);
+    return any_of(regions.begin(), regions.end(),
+                  [address](const Region &region) {
+                      return address >= region.start &&
+                             address < region.start + region.size;
+                  });
+}
+
+void *MappedSegmentStorage::allocate(size_t num_bytes) {
+    size_t size = round_up(num_bytes, SEGMENT_ALIGNMENT);
+    lock_guard<mutex> lock(storage_mutex);
+    num_bytes_allocated += size;
+    vector<void *> &free_list = free_segments[size];
+    if (!free_list.empty()) {
+        void *segment = free_list.back();
+        free_list.pop_back();
+        return segment;
+    }
+    if (static_cast<size_t>(region_end - next_free) < size) {
+        /* The rest of the current region is wasted. Segments are small
+           compared to regions, so this does not matter. */
+        Region &region = map_region(size);
+        next_free = region.start;
+        region_end = region.start + region.size;
+    }
+    void *segment = next_free;
+    next_free += size;
+    return segment;
+}
+
+bool MappedSegmentStorage::deallocate(void *ptr, size_t num_bytes) {
+    lock_guard<mutex> lock(storage_mutex);
+    if (!is_mapped(ptr)) {
+        return false;
+    }
+    size_t size = round_up(num_bytes, SEGMENT_ALIGNMENT);
+    assert(num_bytes_allocated >= size);
+    num_bytes_allocated -= size;
+    free_segments[size].push_back(ptr);
+    return true;
+}
+
+void MappedSegmentStorage::print_statistics(utils::LogProxy &log) {
+    lock_guard<mutex> lock(storage_mutex);
+    size_t resident_bytes = 0;
+    for (const Region &region : regions) {
+        resident_bytes += get_resident_bytes(region);
+    }
+    log << "Mapped segment storage: " << file_size / 1024 << " KB mapped, "
+        << num_bytes_allocated / 1024 << " KB in use, "
+        << resident_bytes / 1024 << " KB resident, "
+        << num_page_outs << " region page-outs" << endl;
+}
+
+void enable_mapped_segment_storage(
+    const string &directory, size_t memory_budget) {
+    assert(!mapped_segment_storage);
+    mapped_segment_storage = new MappedSegmentStorage(directory, memory_budget);
+}
+#else
+MappedSegmentStorage::MappedSegmentStorage(const string &, size_t)
+    : fd(-1), memory_budget(0), region_size(0) {
+    ABORT("Mapped segment storage is not supported on this system.");
+}
+
+MappedSegmentStorage::~MappedSegmentStorage() {
+}
+
+void *MappedSegmentStorage::allocate(size_t) {
+    ABORT("Mapped segment storage is not supported on this system.");
+}
+
+bool MappedSegmentStorage::deallocate(void *, size_t) {
+    return false;
+}
+
+void MappedSegmentStorage::print_statistics(utils::LogProxy &) {
+}
+
+void enable_mapped_segment_storage(const string &, size_t) {
+    cerr << "Mapped segment storage is not supported on this system." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+#endif
+
+MappedSegmentStorage *get_mapped_segment_storage() {
+    return mapped_segment_storage;
+}
+}
@@ -0,0 +1,143 @@
+#ifndef ALGORITHMS_SEGMENT_STORAGE_H
+#define ALGORITHMS_SEGMENT_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace utils {
+class LogProxy;
+}
+
+namespace segmented_vector {
+/*
+  MappedSegmentStorage provides the memory for the segments of
+  SegmentedVector and SegmentedArrayVector (and hence for the state data of
+  StateRegistry and for PerStateInformation and PerStateArray) if the
+  planner is started with a state memory budget.
+
+  Segments are carved out of large regions of a temporary file that is
+  mapped into memory. The file is deleted right after creating it, so it
+  disappears when the planner exits. Since the segments are ordinary
+  mapped memory, their addresses stay stable and all code accessing them
+  is unaffected. However, the kernel can write pages of the file back to
+  disk and free them, unlike anonymous memory, which needs swap space.
+
+  To keep the amount of resident memory within the budget, the storage
+  checks which pages are resident whenever it maps a new region. If they
+  exceed the budget, it pages out regions in clock order (starting with
+  the oldest region and continuing where it stopped the last time), never
+  touching the newest region. Search algorithms mostly access recently
+  generated states, so this approximates evicting the least recently used
+  regions. Evicted pages that are accessed again are read back in by the
+  kernel transparently.
+
+  Note that mapped memory counts towards address-space limits
+  (RLIMIT_AS, as set by the driver's --overall-memory-limit and
+  --search-memory-limit options), so the budget only helps if the memory
+  limit is imposed on resident memory, e.g., by control groups.
+*/
+class MappedSegmentStorage {
+    struct Region {
+        char *start;
+        size_t size;
+        size_t file_offset;
+    };
+
+    const int fd;
+    const size_t memory_budget;
+    const size_t region_size;
+
+    std::mutex storage_mutex;
+    std::vector<Region> regions;
+    size_t file_size;
+    // Unused space at the end of the newest region.
+    char *next_free;
+    char *region_end;
+    std::unordered_map<size_t, std::vector<void *>> free_segments;
+    size_t clock_hand;
+
+    size_t num_bytes_allocated;
+    size_t num_page_outs;
+
+    Region &map_region(size_t num_bytes);
+    size_t get_resident_bytes(const Region &region) const;
+    void page_out(const Region &region);
+    void enforce_memory_budget();
+    bool is_mapped(const void *ptr) const;
+
+public:
+    /*
+      Create the temporary file in the given directory. memory_budget is
+      the number of bytes that the storage tries to keep resident.
+    */
+    MappedSegmentStorage(const std::string &directory, size_t memory_budget);
+    ~MappedSegmentStorage();
+
+    MappedSegmentStorage(const MappedSegmentStorage &) = delete;
+    MappedSegmentStorage &operator=(const MappedSegmentStorage &) = delete;
+
+    void *allocate(size_t num_bytes);
+    // Return false if ptr was not allocated by this storage.
+    bool deallocate(void *ptr, size_t num_bytes);
+
+    void print_statistics(utils::LogProxy &log);
+};
+
+/*
+  Enable the mapped segment storage for all segments allocated from now
+  on. Must be called at most once, before any search components are
+  created. Exits if the system does not support memory mapping.
+*/
+extern void enable_mapped_segment_storage(
+    const std::string &directory, size_t memory_budget);
+
+// Return the mapped segment storage or nullptr if it is not enabled.
+extern MappedSegmentStorage *get_mapped_segment_storage();
+
+/*
+  Allocator used by segmented vectors for their segments. It uses the
+  mapped segment storage if it is enabled and std::allocator otherwise.
+*/
+template<class T>
+class SegmentAllocator {
+public:
+    using value_type = T;
+
+    SegmentAllocator() = default;
+
+    template<class U>
+    SegmentAllocator(const SegmentAllocator<U> &) {
+    }
+
+    T *allocate(size_t n) {
+        MappedSegmentStorage *storage = get_mapped_segment_storage();
+        if (storage) {
+            return static_cast<T *>(storage->allocate(n * sizeof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *ptr, size_t n) {
+        MappedSegmentStorage *storage = get_mapped_segment_storage();
+        if (!storage || !storage->deallocate(ptr, n * sizeof(T))) {
+            std::allocator<T>().deallocate(ptr, n);
+        }
+    }
+
+    template<class U>
+    bool operator==(const SegmentAllocator<U> &) const {
+        return true;
+    }
+
+    template<class U>
+    bool operator!=(const SegmentAllocator<U> &) const {
+        return false;
+    }
+};
+}
+
+#endif
@@ -40,19 +40,29 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
         }
 
         // Cross-reference rules and literals
+        dependent_vars.resize(variables.size());
+        rules_by_effect_var.resize(variables.size());
+        rule_conditions.resize(rules.size());
         for (OperatorProxy axiom : axioms) {
             // Ignore axioms which set the variable to its default value.
             int position = axiom_id_to_position[axiom.get_id()];
             if (position != -1) {
                 EffectProxy effect = axiom.get_effects()[0];
+                AxiomRule *rule = &rules[position];
+                rules_by_effect_var[rule->effect_var].push_back(position);
                 for (FactProxy condition : effect.get_conditions()) {
                     int var_id = condition.get_variable().get_id();
                     int val = condition.get_value();
-                    AxiomRule *rule = &rules[position];
                     axiom_literals[var_id][val].condition_of.push_back(rule);
+                    rule_conditions[position].push_back(condition.get_pair());
+                    dependent_vars[var_id].push_back(rule->effect_var);
                 }
             }
         }
+        for (vector<int> &vars : dependent_vars) {
+            sort(vars.begin(), vars.end());
+            vars.erase(unique(vars.begin(), vars.end()), vars.end());
+        }
 
         // Initialize negation-by-failure information
         int last_layer = -1;
@@ -76,11 +86,36 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
         }
 
         default_values.reserve(variables.size());
+        axiom_layers.reserve(variables.size());
         for (VariableProxy var : variables) {
-            if (var.is_derived())
+            if (var.is_derived()) {
                 default_values.emplace_back(var.get_default_axiom_value());
-            else
+                axiom_layers.emplace_back(var.get_axiom_layer());
+            } else {
                 default_values.emplace_back(-1);
+                axiom_layers.emplace_back(-1);
+            }
+        }
+
+        is_affected.resize(variables.size(), false);
+        affected_vars_by_layer.resize(last_layer + 1);
+    }
+}
+
+void AxiomEvaluator::apply_horn_rules(vector<int> &state) {
+    while (!queue.empty()) {
+        const AxiomLiteral *curr_literal = queue.back();
+        queue.pop_back();
+        for (size_t i = 0; i < curr_literal->condition_of.size(); ++i) {
+            AxiomRule *rule = curr_literal->condition_of[i];
+            if (--rule->unsatisfied_conditions == 0) {
+                int var_no = rule->effect_var;
+                int val = rule->effect_val;
+                if (state[var_no] != val) {
+                    state[var_no] = val;
+                    queue.push_back(rule->effect_literal);
+                }
+            }
         }
     }
 }
@@ -125,22 +160,7 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
     }
 
     for (size_t layer_no = 0; layer_no < nbf_info_by_layer.size(); ++layer_no) {
-        // Apply Horn rules.
-        while (!queue.empty()) {
-            const AxiomLiteral *curr_literal = queue.back();
-            queue.pop_back();
-            for (size_t i = 0; i < curr_literal->condition_of.size(); ++i) {
-                AxiomRule *rule = curr_literal->condition_of[i];
-                if (--rule->unsatisfied_conditions == 0) {
-                    int var_no = rule->effect_var;
-                    int val = rule->effect_val;
-                    if (state[var_no] != val) {
-                        state[var_no] = val;
-                        queue.push_back(rule->effect_literal);
-                    }
-                }
-            }
-        }
+        apply_horn_rules(state);
 
         /*
           Apply negation by failure rules. Skip this in last iteration
@@ -159,4 +179,96 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
     }
 }
 
+void AxiomEvaluator::collect_affected_vars(const vector<int> &changed_vars) {
+    assert(affected_vars.empty());
+    for (int var : changed_vars) {
+        for (int dependent_var : dependent_vars[var]) {
+            if (!is_affected[dependent_var]) {
+                is_affected[dependent_var] = true;
+                affected_vars.push_back(dependent_var);
+            }
+        }
+    }
+    // affected_vars grows while we iterate over it.
+    for (size_t i = 0; i < affected_vars.size(); ++i) {
+        for (int dependent_var : dependent_vars[affected_vars[i]]) {
+            if (!is_affected[dependent_var]) {
+                is_affected[dependent_var] = true;
+                affected_vars.push_back(dependent_var);
+            }
+        }
+    }
+}
+
+void AxiomEvaluator::evaluate_incrementally(
+    vector<int> &state, const vector<int> &changed_vars) {
+    if (!task_has_axioms)
+        return;
+
+#ifndef NDEBUG
+    vector<int> expected_state = state;
+    evaluate(expected_state);
+#endif
+
+    collect_affected_vars(changed_vars);
+
+    /*
+      Derived variables that are not affected keep their values, so we
+      reset the affected variables and only use the rules deriving them.
+      Conditions on unaffected variables are already final, so we count
+      them right away. Conditions on affected variables are counted as
+      unsatisfied until the propagation below reaches them.
+    */
+    assert(queue.empty());
+    for (int var : affected_vars) {
+        state[var] = default_values[var];
+        affected_vars_by_layer[axiom_layers[var]].push_back(var);
+    }
+    for (int var : affected_vars) {
+        for (int rule_id : rules_by_effect_var[var]) {
+            AxiomRule &rule = rules[rule_id];
+            int unsatisfied_conditions = 0;
+            for (const FactPair &condition : rule_conditions[rule_id]) {
+                if (is_affected[condition.var] ||
+                    state[condition.var] != condition.value) {
+                    ++unsatisfied_conditions;
+                }
+            }
+            rule.unsatisfied_conditions = unsatisfied_conditions;
+            if (unsatisfied_conditions == 0 && state[var] != rule.effect_val) {
+                state[var] = rule.effect_val;
+                queue.push_back(rule.effect_literal);
+            }
+        }
+    }
+
+    /*
+      All rules with a condition on an affected variable derive an
+      affected variable, so the propagation never touches rules of
+      unaffected variables.
+    */
+    for (size_t layer_no = 0; layer_no < affected_vars_by_layer.size(); ++layer_no) {
+        apply_horn_rules(state);
+
+        vector<int> &layer_vars = affected_vars_by_layer[layer_no];
+        if (layer_no != affected_vars_by_layer.size() - 1) {
+            for (int var : layer_vars) {
+                int default_value = default_values[var];
+                if (state[var] == default_value)
+                    queue.push_back(&axiom_literals[var][default_value]);
+            }
+        }
+        layer_vars.clear();
+    }
+
+    for (int var : affected_vars) {
+        is_affected[var] = false;
+    }
+    affected_vars.clear();
+
+#ifndef NDEBUG
+    assert(state == expected_state);
+#endif
+}
+
 PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
@@ -47,6 +47,18 @@ class AxiomEvaluator {
       interface in the time-critical evaluate method.
     */
     std::vector<int> default_values;
+    // Axiom layer of each derived variable and -1 for non-derived variables.
+    std::vector<int> axiom_layers;
+
+    /*
+      Data for incremental evaluation. For each variable, dependent_vars
+      lists the derived variables with a rule that has a condition on the
+      variable. The rules and their conditions are indexed by the rule
+      position in the rules vector.
+    */
+    std::vector<std::vector<int>> dependent_vars;
+    std::vector<std::vector<int>> rules_by_effect_var;
+    std::vector<std::vector<FactPair>> rule_conditions;
 
     /*
       The queue is an instance variable rather than a local variable
@@ -54,12 +66,31 @@ class AxiomEvaluator {
     */
     std::vector<const AxiomLiteral *> queue;
 
+    // Reused by evaluate_incrementally.
+    std::vector<bool> is_affected;
+    std::vector<int> affected_vars;
+    std::vector<std::vector<int>> affected_vars_by_layer;
+
+    void apply_horn_rules(std::vector<int> &state);
+    void collect_affected_vars(const std::vector<int> &changed_vars);
+
     template<typename Values, typename Accessor>
     void evaluate_aux(Values &values, const Accessor &accessor);
 public:
     explicit AxiomEvaluator(const TaskProxy &task_proxy);
 
     void evaluate(std::vector<int> &state);
+
+    /*
+      Recompute the derived variables of a state after the given
+      non-derived variables changed. The derived variables must hold their
+      correct values for the state before the change. Only derived
+      variables that (transitively) depend on the changed variables are
+      recomputed; all others keep their values. The result is the same as
+      for evaluate.
+    */
+    void evaluate_incrementally(
+        std::vector<int> &state, const std::vector<int> &changed_vars);
 };
 
 extern PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
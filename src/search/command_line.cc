@@ -3,6 +3,7 @@
 #include "plan_manager.h"
 #include "search_engine.h"
 
+#include "algorithms/segment_storage.h"
 #include "parser/lexical_analyzer.h"
 #include "parser/syntax_analyzer.h"
 #include "plugins/any.h"
@@ -84,29 +85,23 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(const vector<string> &args) {
     string plan_filename = "sas_plan";
     int num_previously_generated_plans = 0;
     bool is_part_of_anytime_portfolio = false;
+    int state_memory_budget_in_mb = -1;
+    string state_storage_directory = ".";
 
     using SearchPtr = shared_ptr<SearchEngine>;
     SearchPtr engine = nullptr;
+    string search_arg;
     // TODO: Remove code duplication.
     for (size_t i = 0; i < args.size(); ++i) {
         string arg = args[i];
         bool is_last = (i == args.size() - 1);
         if (arg == "--search") {
-            if (engine)
+            if (!search_arg.empty())
                 input_error("multiple --search arguments defined");
             if (is_last)
                 input_error("missing argument after --search");
             ++i;
-            string search_arg = args[i];
-            try {
-                parser::TokenStream tokens = parser::split_tokens(search_arg);
-                parser::ASTNodePtr parsed = parser::parse(tokens);
-                parser::DecoratedASTNodePtr decorated = parsed->decorate();
-                plugins::Any constructed = decorated->construct();
-                engine = plugins::any_cast<SearchPtr>(constructed);
-            } catch (const utils::ContextError &e) {
-                input_error(e.get_message());
-            }
+            search_arg = args[i];
         } else if (arg == "--help") {
             cout << "Help:" << endl;
             bool txt2tags = false;
@@ -149,11 +144,43 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(const vector<string> &args) {
             num_previously_generated_plans = parse_int_arg(arg, args[i]);
             if (num_previously_generated_plans < 0)
                 input_error("argument for --internal-previous-portfolio-plans must be positive");
+        } else if (arg == "--state-memory-budget") {
+            if (is_last)
+                input_error("missing argument after --state-memory-budget");
+            ++i;
+            state_memory_budget_in_mb = parse_int_arg(arg, args[i]);
+            if (state_memory_budget_in_mb <= 0)
+                input_error("argument for --state-memory-budget must be positive");
+        } else if (arg == "--state-storage-dir") {
+            if (is_last)
+                input_error("missing argument after --state-storage-dir");
+            ++i;
+            state_storage_directory = args[i];
         } else {
             input_error("unknown option " + arg);
         }
     }
 
+    /* The segment storage must be enabled before the search components
+       that store per-state data are constructed. */
+    if (state_memory_budget_in_mb != -1) {
+        segmented_vector::enable_mapped_segment_storage(
+            state_storage_directory,
+            static_cast<size_t>(state_memory_budget_in_mb) * 1024 * 1024);
+    }
+
+    if (!search_arg.empty()) {
+        try {
+            parser::TokenStream tokens = parser::split_tokens(search_arg);
+            parser::ASTNodePtr parsed = parser::parse(tokens);
+            parser::DecoratedASTNodePtr decorated = parsed->decorate();
+            plugins::Any constructed = decorated->construct();
+            engine = plugins::any_cast<SearchPtr>(constructed);
+        } catch (const utils::ContextError &e) {
+            input_error(e.get_message());
+        }
+    }
+
     if (engine) {
         PlanManager &plan_manager = engine->get_plan_manager();
         plan_manager.set_plan_filename(plan_filename);
@@ -200,5 +227,13 @@ string usage(const string &progname) {
            "    This planner call is part of a portfolio which already created\n"
            "    plan files FILENAME.1 up to FILENAME.COUNTER.\n"
            "    Start enumerating plan files with COUNTER+1, i.e. FILENAME.COUNTER+1\n\n"
+           "--state-memory-budget MB\n"
+           "    Store registered states and per-state information in a\n"
+           "    memory-mapped file and try to keep at most MB megabytes of it\n"
+           "    in memory. Only helps if the memory limit applies to resident\n"
+           "    memory, not to the address space.\n\n"
+           "--state-storage-dir DIRECTORY\n"
+           "    Directory for the file used by --state-memory-budget\n"
+           "    (default: current directory)\n\n"
            "See https://www.fast-downward.org for details.";
 }
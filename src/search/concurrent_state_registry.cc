@@ -0,0 +1,118 @@
+#include "concurrent_state_registry.h"
+
+#include "task_proxy.h"
+
+#include "task_utils/task_properties.h"
+#include "utils/logging.h"
+#include "utils/system.h"
+
+#include <cassert>
+#include <cstdint>
+
+using namespace std;
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const TaskProxy &task_proxy, int num_shards)
+    : task_proxy(task_proxy),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      bins_per_state(state_packer.get_num_bins()),
+      hash_function(StateRegistry::get_state_data_hash_function(bins_per_state)),
+      equal_function(StateRegistry::get_state_data_equal_function(bins_per_state)),
+      segments(new atomic<PackedStateBin *>[MAX_NUM_SEGMENTS]),
+      next_unreserved_id(0),
+      num_registered_states(0) {
+    assert(num_shards >= 1);
+    int rounded_num_shards = 1;
+    while (rounded_num_shards < num_shards) {
+        rounded_num_shards *= 2;
+    }
+    shards.reserve(rounded_num_shards);
+    for (int i = 0; i < rounded_num_shards; ++i) {
+        shards.push_back(utils::make_unique_ptr<Shard>(*this));
+    }
+    for (int i = 0; i < MAX_NUM_SEGMENTS; ++i) {
+        segments[i].store(nullptr, memory_order_relaxed);
+    }
+}
+
+ConcurrentStateRegistry::~ConcurrentStateRegistry() {
+    for (int i = 0; i < MAX_NUM_SEGMENTS; ++i) {
+        delete[] segments[i].load(memory_order_relaxed);
+    }
+}
+
+StateID ConcurrentStateRegistry::insert_state(
+    Writer &writer, const PackedStateBin *buffer) {
+    assert(&writer.registry == this);
+    if (writer.next_id == writer.end_id) {
+        int first_id = next_unreserved_id.fetch_add(
+            STATES_PER_CHUNK, memory_order_relaxed);
+        if (first_id > MAX_NUM_SEGMENTS * STATES_PER_SEGMENT - STATES_PER_CHUNK) {
+            cerr << "Concurrent state registry is full." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        atomic<PackedStateBin *> &segment =
+            segments[first_id >> STATES_PER_SEGMENT_LOG];
+        if (!segment.load(memory_order_acquire)) {
+            PackedStateBin *new_segment =
+                new PackedStateBin[static_cast<size_t>(STATES_PER_SEGMENT) *
+                                   bins_per_state];
+            PackedStateBin *expected = nullptr;
+            if (!segment.compare_exchange_strong(
+                    expected, new_segment, memory_order_acq_rel)) {
+                // Another thread allocated the segment first.
+                delete[] new_segment;
+            }
+        }
+        writer.next_id = first_id;
+        writer.end_id = first_id + STATES_PER_CHUNK;
+    }
+
+    int id = writer.next_id;
+    PackedStateBin *data = get_mutable_state_data(id);
+    copy(buffer, buffer + bins_per_state, data);
+
+    /*
+      The hash sets use the low bits of the hash to find buckets, so we
+      use the high bits to select the shard.
+    */
+    uint64_t hash = hash_function(data, bins_per_state);
+    Shard &shard = *shards[(hash * shards.size()) >> 32];
+    pair<int, bool> result;
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        result = shard.registered_states.insert(id);
+    }
+    if (result.second) {
+        ++writer.next_id;
+        num_registered_states.fetch_add(1, memory_order_relaxed);
+    }
+    return StateID(result.first);
+}
+
+StateID ConcurrentStateRegistry::insert_initial_state(Writer &writer) {
+    task_properties::verify_no_axioms(task_proxy);
+    vector<PackedStateBin> buffer(bins_per_state, 0);
+    State initial_state = task_proxy.get_initial_state();
+    for (size_t i = 0; i < initial_state.size(); ++i) {
+        state_packer.set(buffer.data(), i, initial_state[i].get_value());
+    }
+    return insert_state(writer, buffer.data());
+}
+
+State ConcurrentStateRegistry::lookup_state(StateID id) const {
+    const PackedStateBin *buffer = lookup_state_data(id);
+    int num_variables = task_proxy.get_variables().size();
+    vector<int> values(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        values[var] = state_packer.get(buffer, var);
+    }
+    return task_proxy.create_state(move(values));
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy &log) const {
+    log << "Number of registered states: " << size() << endl;
+    log << "Number of reserved state IDs: "
+        << next_unreserved_id.load(memory_order_relaxed) << endl;
+    log << "Number of registry shards: " << shards.size() << endl;
+}
@@ -0,0 +1,172 @@
+#ifndef CONCURRENT_STATE_REGISTRY_H
+#define CONCURRENT_STATE_REGISTRY_H
+
+#include "state_id.h"
+#include "state_registry.h"
+
+#include "algorithms/int_hash_set.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+  Thread-safe variant of StateRegistry: any number of threads may register
+  and look up states concurrently.
+
+  Duplicate detection is split over a fixed number of shards, each of which
+  is an IntHashSet protected by its own mutex. A state goes to the shard
+  selected by the high bits of its hash (the hash sets use the low bits), so
+  threads rarely contend for a shard and enlarging a hash set only blocks
+  the threads that access this shard.
+
+  The packed state data lives in segments that are allocated on demand and
+  never move, so looking up the data of a state ID needs no locking. Every
+  thread registers states through its own Writer, which reserves chunks of
+  consecutive state IDs and appends to them without synchronization. A
+  state whose insertion reveals a duplicate does not use up its slot.
+  Consequently, state IDs are unique but not contiguous, and chunks that
+  are not filled leave gaps, so size() is smaller than the range of IDs.
+
+  Unlike StateRegistry, this class does not evaluate axioms, does not
+  support PerStateInformation, and the states returned by lookup_state are
+  unregistered states holding unpacked values.
+*/
+class ConcurrentStateRegistry {
+    static const int STATES_PER_SEGMENT_LOG = 14;
+    static const int STATES_PER_SEGMENT = 1 << STATES_PER_SEGMENT_LOG;
+    static const int STATES_PER_CHUNK = 256;
+    static const int MAX_NUM_SEGMENTS = (1 << 30) / STATES_PER_SEGMENT;
+    static_assert(STATES_PER_SEGMENT % STATES_PER_CHUNK == 0,
+                  "Chunks must not cross segment boundaries.");
+
+    struct StateIDSemanticHash {
+        const ConcurrentStateRegistry &registry;
+        explicit StateIDSemanticHash(const ConcurrentStateRegistry &registry)
+            : registry(registry) {
+        }
+
+        int_hash_set::HashType operator()(int id) const {
+            return registry.hash_function(
+                registry.get_state_data(id), registry.bins_per_state);
+        }
+    };
+
+    struct StateIDSemanticEqual {
+        const ConcurrentStateRegistry &registry;
+        explicit StateIDSemanticEqual(const ConcurrentStateRegistry &registry)
+            : registry(registry) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            return registry.equal_function(
+                registry.get_state_data(lhs), registry.get_state_data(rhs),
+                registry.bins_per_state);
+        }
+    };
+
+    using StateIDSet = int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+
+    struct Shard {
+        std::mutex mutex;
+        StateIDSet registered_states;
+
+        explicit Shard(const ConcurrentStateRegistry &registry)
+            : registered_states(StateIDSemanticHash(registry),
+                                StateIDSemanticEqual(registry)) {
+        }
+    };
+
+    TaskProxy task_proxy;
+    const int_packer::IntPacker &state_packer;
+    const int bins_per_state;
+    const StateDataHashFunction hash_function;
+    const StateDataEqualFunction equal_function;
+
+    std::unique_ptr<std::atomic<PackedStateBin *>[]> segments;
+    std::atomic<int> next_unreserved_id;
+    std::atomic<int> num_registered_states;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    const PackedStateBin *get_state_data(int id) const {
+        const PackedStateBin *segment =
+            segments[id >> STATES_PER_SEGMENT_LOG].load(std::memory_order_acquire);
+        return segment +
+               static_cast<size_t>(id & (STATES_PER_SEGMENT - 1)) * bins_per_state;
+    }
+
+    PackedStateBin *get_mutable_state_data(int id) {
+        return const_cast<PackedStateBin *>(get_state_data(id));
+    }
+
+public:
+    /*
+      Registers states on behalf of one thread. A writer must not be used
+      by several threads at the same time.
+    */
+    class Writer {
+        friend class ConcurrentStateRegistry;
+        ConcurrentStateRegistry &registry;
+        int next_id;
+        int end_id;
+public:
+        explicit Writer(ConcurrentStateRegistry &registry)
+            : registry(registry), next_id(0), end_id(0) {
+        }
+    };
+
+    /*
+      num_shards is rounded up to the next power of two. Use a multiple of
+      the number of threads to keep contention low.
+    */
+    ConcurrentStateRegistry(const TaskProxy &task_proxy, int num_shards);
+    ~ConcurrentStateRegistry();
+
+    ConcurrentStateRegistry(const ConcurrentStateRegistry &) = delete;
+    ConcurrentStateRegistry &operator=(const ConcurrentStateRegistry &) = delete;
+
+    const TaskProxy &get_task_proxy() const {
+        return task_proxy;
+    }
+
+    int get_bins_per_state() const {
+        return bins_per_state;
+    }
+
+    /*
+      Registers the state with the given packed data if this was not done
+      before and returns its ID. The data is copied.
+    */
+    StateID insert_state(Writer &writer, const PackedStateBin *buffer);
+
+    /*
+      Registers the initial state if this was not done before and returns
+      its ID. The task must not have axioms.
+    */
+    StateID insert_initial_state(Writer &writer);
+
+    /*
+      Returns the packed data of the state with the given ID. The ID must be
+      known to the calling thread through insert_state or through some
+      other synchronization with the thread that inserted it.
+    */
+    const PackedStateBin *lookup_state_data(StateID id) const {
+        return get_state_data(id.value);
+    }
+
+    // Returns an unregistered copy of the state with the given ID.
+    State lookup_state(StateID id) const;
+
+    /*
+      Returns the number of states registered so far. Concurrent insertions
+      may or may not be included.
+    */
+    size_t size() const {
+        return num_registered_states.load(std::memory_order_relaxed);
+    }
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+
+#endif
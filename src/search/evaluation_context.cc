@@ -17,7 +17,8 @@ EvaluationContext::EvaluationContext(
       g_value(g_value),
       preferred(is_preferred),
       statistics(statistics),
-      calculate_preferred(calculate_preferred) {
+      calculate_preferred(calculate_preferred),
+      evaluation_batch(nullptr) {
 }
 
 
@@ -96,3 +97,11 @@ EvaluationContext::get_preferred_operators(Evaluator *eval) {
 bool EvaluationContext::get_calculate_preferred() const {
     return calculate_preferred;
 }
+
+void EvaluationContext::set_evaluation_batch(const vector<State> *states) {
+    evaluation_batch = states;
+}
+
+const vector<State> *EvaluationContext::get_evaluation_batch() const {
+    return evaluation_batch;
+}
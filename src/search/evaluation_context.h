@@ -7,6 +7,7 @@
 #include "task_proxy.h"
 
 #include <unordered_map>
+#include <vector>
 
 class Evaluator;
 class SearchStatistics;
@@ -47,6 +48,7 @@ class EvaluationContext {
     bool preferred;
     SearchStatistics *statistics;
     bool calculate_preferred;
+    const std::vector<State> *evaluation_batch;
 
     static const int INVALID = -1;
 
@@ -110,6 +112,17 @@ public:
     int get_evaluator_value_or_infinity(Evaluator *eval);
     const std::vector<OperatorID> &get_preferred_operators(Evaluator *eval);
     bool get_calculate_preferred() const;
+
+    /*
+      The evaluation batch contains states (including the state of this
+      context) that the search engine evaluates one after the other, e.g.,
+      the new successors of an expanded state. Heuristics that support
+      batch evaluation can compute their estimates for all states of the
+      batch when the first of them is evaluated. The batch must outlive
+      the context.
+    */
+    void set_evaluation_batch(const std::vector<State> *states);
+    const std::vector<State> *get_evaluation_batch() const;
 };
 
 #endif
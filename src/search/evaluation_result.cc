@@ -1,10 +1,18 @@
 #include "evaluation_result.h"
 
+#include <cassert>
+
 using namespace std;
 
 const int EvaluationResult::INFTY = numeric_limits<int>::max();
 
-EvaluationResult::EvaluationResult() : evaluator_value(UNINITIALIZED) {
+static const vector<OperatorID> no_preferred_operators;
+
+EvaluationResult::EvaluationResult()
+    : evaluator_value(UNINITIALIZED),
+      count_evaluation(false),
+      preferred_operators_generation(0),
+      preferred_operators(nullptr) {
 }
 
 bool EvaluationResult::is_uninitialized() const {
@@ -20,7 +28,11 @@ int EvaluationResult::get_evaluator_value() const {
 }
 
 const vector<OperatorID> &EvaluationResult::get_preferred_operators() const {
-    return preferred_operators;
+    if (!preferred_operators) {
+        return no_preferred_operators;
+    }
+    assert(preferred_operators->generation == preferred_operators_generation);
+    return preferred_operators->operators;
 }
 
 bool EvaluationResult::get_count_evaluation() const {
@@ -32,8 +44,9 @@ void EvaluationResult::set_evaluator_value(int value) {
 }
 
 void EvaluationResult::set_preferred_operators(
-    vector<OperatorID> &&preferred_ops) {
-    preferred_operators = move(preferred_ops);
+    const PreferredOperatorsBuffer &buffer) {
+    preferred_operators = &buffer;
+    preferred_operators_generation = buffer.generation;
 }
 
 void EvaluationResult::set_count_evaluation(bool count_eval) {
@@ -6,12 +6,32 @@
 #include <limits>
 #include <vector>
 
+/*
+  Storage for the preferred operators of an evaluator that is reused for
+  every evaluation. Evaluation results only point to the buffer, so
+  creating and copying them does not allocate memory. The generation is
+  increased whenever the buffer is refilled, which invalidates the
+  preferred operators of all earlier results. Therefore, the preferred
+  operators of a result must be retrieved before the evaluator computes
+  the next result.
+*/
+struct PreferredOperatorsBuffer {
+    std::vector<OperatorID> operators;
+    int generation = 0;
+
+    void clear() {
+        operators.clear();
+        ++generation;
+    }
+};
+
 class EvaluationResult {
     static const int UNINITIALIZED = -2;
 
     int evaluator_value;
-    std::vector<OperatorID> preferred_operators;
     bool count_evaluation;
+    int preferred_operators_generation;
+    const PreferredOperatorsBuffer *preferred_operators;
 public:
     // "INFINITY" is an ISO C99 macro and "INFINITE" is a macro in windows.h.
     static const int INFTY;
@@ -45,7 +65,7 @@ public:
     const std::vector<OperatorID> &get_preferred_operators() const;
 
     void set_evaluator_value(int value);
-    void set_preferred_operators(std::vector<OperatorID> &&preferred_operators);
+    void set_preferred_operators(const PreferredOperatorsBuffer &buffer);
     void set_count_evaluation(bool count_eval);
 };
 
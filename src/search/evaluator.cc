@@ -1,19 +1,24 @@
 #include "evaluator.h"
 
+#include "task_proxy.h"
+
 #include "plugins/plugin.h"
 #include "utils/logging.h"
 #include "utils/system.h"
 
+#include <atomic>
 #include <cassert>
 
 using namespace std;
 
+static atomic<int> next_evaluator_id(0);
 
 Evaluator::Evaluator(const plugins::Options &opts,
                      bool use_for_reporting_minima,
                      bool use_for_boosting,
                      bool use_for_counting_evaluations)
-    : description(opts.get_unparsed_config()),
+    : id(next_evaluator_id++),
+      description(opts.get_unparsed_config()),
       use_for_reporting_minima(use_for_reporting_minima),
       use_for_boosting(use_for_boosting),
       use_for_counting_evaluations(use_for_counting_evaluations),
@@ -24,6 +29,15 @@ bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+void Evaluator::notify_state_transitions(
+    const State &parent_state, const vector<OperatorID> &op_ids,
+    const vector<State> &states) {
+    assert(op_ids.size() == states.size());
+    for (size_t i = 0; i < op_ids.size(); ++i) {
+        notify_state_transition(parent_state, op_ids[i], states[i]);
+    }
+}
+
 void Evaluator::report_value_for_initial_state(
     const EvaluationResult &result) const {
     if (log.is_at_least_normal()) {
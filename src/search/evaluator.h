@@ -6,6 +6,7 @@
 #include "utils/logging.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
@@ -15,6 +16,11 @@ class Options;
 }
 
 class Evaluator {
+    /*
+      Dense number in [0, number of constructed evaluators) that
+      EvaluatorCache uses to index its results.
+    */
+    const int id;
     const std::string description;
     const bool use_for_reporting_minima;
     const bool use_for_boosting;
@@ -60,6 +66,25 @@ public:
         const State & /*state*/) {
     }
 
+    /*
+      Notify the evaluator of the transitions from *parent_state* with
+      each operator in *op_ids* to the corresponding state in *states*.
+      Evaluators that can share work between the successors of a state
+      should override the default implementation, which notifies them of
+      each transition separately.
+    */
+    virtual void notify_state_transitions(
+        const State &parent_state,
+        const std::vector<OperatorID> &op_ids,
+        const std::vector<State> &states);
+
+    /*
+      Search engines call print_statistics for their path-dependent
+      evaluators when printing their own statistics.
+    */
+    virtual void print_statistics() const {
+    }
+
     /*
       compute_result should compute the estimate and possibly
       preferred operators for the given evaluation context and return
@@ -86,6 +111,9 @@ public:
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
+    int get_id() const {
+        return id;
+    }
     const std::string &get_description() const;
     bool is_used_for_reporting_minima() const;
     bool is_used_for_boosting() const;
@@ -1,8 +1,23 @@
 #include "evaluator_cache.h"
 
+#include "evaluator.h"
+
 using namespace std;
 
 
 EvaluationResult &EvaluatorCache::operator[](Evaluator *eval) {
-    return eval_results[eval];
+    Entry &slot = slots[eval->get_id() & (NUM_SLOTS - 1)];
+    if (slot.evaluator == eval) {
+        return slot.result;
+    } else if (!slot.evaluator) {
+        slot.evaluator = eval;
+        return slot.result;
+    }
+    for (Entry &entry : overflow) {
+        if (entry.evaluator == eval) {
+            return entry.result;
+        }
+    }
+    overflow.push_back({eval, EvaluationResult()});
+    return overflow.back().result;
 }
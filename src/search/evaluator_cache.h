@@ -3,27 +3,46 @@
 
 #include "evaluation_result.h"
 
-#include <unordered_map>
+#include <array>
+#include <vector>
 
 class Evaluator;
 
-using EvaluationResults = std::unordered_map<Evaluator *, EvaluationResult>;
-
 /*
   Store evaluation results for evaluators.
+
+  Evaluation contexts are created (and, in lazy search, copied) for every
+  generated state, so the cache avoids memory allocations in the common
+  case: the result of an evaluator is stored in a fixed-size array at the
+  position given by its ID (see Evaluator::get_id). Only if this slot is
+  already used by another evaluator, which happens if more evaluators
+  than array entries exist, is the result stored in a vector.
 */
 class EvaluatorCache {
-    EvaluationResults eval_results;
+    static const int NUM_SLOTS = 16;
+    static_assert((NUM_SLOTS & (NUM_SLOTS - 1)) == 0,
+                  "Number of slots must be a power of two.");
+
+    struct Entry {
+        Evaluator *evaluator = nullptr;
+        EvaluationResult result;
+    };
+
+    std::array<Entry, NUM_SLOTS> slots;
+    std::vector<Entry> overflow;
 
 public:
     EvaluationResult &operator[](Evaluator *eval);
 
     template<class Callback>
     void for_each_evaluator_result(const Callback &callback) const {
-        for (const auto &element : eval_results) {
-            const Evaluator *eval = element.first;
-            const EvaluationResult &result = element.second;
-            callback(eval, result);
+        for (const Entry &entry : slots) {
+            if (entry.evaluator) {
+                callback(entry.evaluator, entry.result);
+            }
+        }
+        for (const Entry &entry : overflow) {
+            callback(entry.evaluator, entry.result);
         }
     }
 };
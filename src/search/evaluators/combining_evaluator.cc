@@ -11,6 +11,7 @@ namespace combining_evaluator {
 CombiningEvaluator::CombiningEvaluator(const plugins::Options &opts)
     : Evaluator(opts),
       subevaluators(opts.get_list<shared_ptr<Evaluator>>("evals")) {
+    values.reserve(subevaluators.size());
     all_dead_ends_are_reliable = true;
     for (const shared_ptr<Evaluator> &subevaluator : subevaluators)
         if (!subevaluator->dead_ends_are_reliable())
@@ -28,8 +29,7 @@ EvaluationResult CombiningEvaluator::compute_result(
     EvaluationContext &eval_context) {
     // This marks no preferred operators.
     EvaluationResult result;
-    vector<int> values;
-    values.reserve(subevaluators.size());
+    values.clear();
 
     // Collect component values. Return infinity if any is infinite.
     for (const shared_ptr<Evaluator> &subevaluator : subevaluators) {
@@ -16,6 +16,8 @@ namespace combining_evaluator {
 class CombiningEvaluator : public Evaluator {
     std::vector<std::shared_ptr<Evaluator>> subevaluators;
     bool all_dead_ends_are_reliable;
+    // Reused for every evaluation to avoid allocating memory.
+    std::vector<int> values;
 protected:
     virtual int combine_values(const std::vector<int> &values) = 0;
 public:
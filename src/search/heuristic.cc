@@ -8,6 +8,7 @@
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -16,6 +17,7 @@ using namespace std;
 
 Heuristic::Heuristic(const plugins::Options &opts)
     : Evaluator(opts, true, true, true),
+      batch_registry(nullptr),
       heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
@@ -26,7 +28,62 @@ Heuristic::~Heuristic() {
 }
 
 void Heuristic::set_preferred(const OperatorProxy &op) {
-    preferred_operators.insert(op.get_ancestor_operator_id(tasks::g_root_task.get()));
+    OperatorID op_id = op.get_ancestor_operator_id(tasks::g_root_task.get());
+    int index = op_id.get_index();
+    if (index >= static_cast<int>(is_preferred.size())) {
+        is_preferred.resize(index + 1, false);
+    }
+    if (!is_preferred[index]) {
+        is_preferred[index] = true;
+        preferred_operators.operators.push_back(op_id);
+    }
+}
+
+void Heuristic::clear_preferred_operators() {
+    for (OperatorID op_id : preferred_operators.operators) {
+        is_preferred[op_id.get_index()] = false;
+    }
+    preferred_operators.clear();
+}
+
+void Heuristic::compute_heuristic_batch(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    values.clear();
+    for (const State &state : ancestor_states) {
+        values.push_back(compute_heuristic(state));
+    }
+}
+
+int Heuristic::compute_heuristic_in_batch(
+    const State &state, const vector<State> &batch) {
+    /*
+      States of different registries (e.g., of different iterations of
+      an iterated search) can have the same ID.
+    */
+    auto find_state = [&]() {
+            if (state.get_registry() != batch_registry) {
+                return batch_state_ids.end();
+            }
+            return find(batch_state_ids.begin(), batch_state_ids.end(),
+                        state.get_id());
+        };
+    auto it = find_state();
+    if (it == batch_state_ids.end()) {
+        batch_registry = batch.empty() ? nullptr : batch[0].get_registry();
+        batch_state_ids.clear();
+        for (const State &batch_state : batch) {
+            assert(batch_state.get_registry() == batch_registry);
+            batch_state_ids.push_back(batch_state.get_id());
+        }
+        compute_heuristic_batch(batch, batch_values);
+        assert(batch_values.size() == batch_state_ids.size());
+        it = find_state();
+        if (it == batch_state_ids.end()) {
+            // The batch does not contain the state.
+            return compute_heuristic(state);
+        }
+    }
+    return batch_values[it - batch_state_ids.begin()];
 }
 
 State Heuristic::convert_ancestor_state(const State &ancestor_state) const {
@@ -46,7 +103,7 @@ void Heuristic::add_options_to_feature(plugins::Feature &feature) {
 EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     EvaluationResult result;
 
-    assert(preferred_operators.empty());
+    clear_preferred_operators();
 
     const State &state = eval_context.get_state();
     bool calculate_preferred = eval_context.get_calculate_preferred();
@@ -58,7 +115,12 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
     } else {
-        heuristic = compute_heuristic(state);
+        const vector<State> *batch = eval_context.get_evaluation_batch();
+        if (batch && !calculate_preferred && supports_batch_evaluation()) {
+            heuristic = compute_heuristic_in_batch(state, *batch);
+        } else {
+            heuristic = compute_heuristic(state);
+        }
         if (cache_evaluator_values) {
             heuristic_cache[state] = HEntry(heuristic, false);
         }
@@ -75,7 +137,7 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
           have a dead end, we don't want to actually report any
           preferred operators.
         */
-        preferred_operators.clear();
+        clear_preferred_operators();
         heuristic = EvaluationResult::INFTY;
     }
 
@@ -83,14 +145,13 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     TaskProxy global_task_proxy = state.get_task();
     OperatorsProxy global_operators = global_task_proxy.get_operators();
     if (heuristic != EvaluationResult::INFTY) {
-        for (OperatorID op_id : preferred_operators)
+        for (OperatorID op_id : preferred_operators.operators)
             assert(task_properties::is_applicable(global_operators[op_id], state));
     }
 #endif
 
     result.set_evaluator_value(heuristic);
-    result.set_preferred_operators(preferred_operators.pop_as_vector());
-    assert(preferred_operators.empty());
+    result.set_preferred_operators(preferred_operators);
 
     return result;
 }
@@ -1,13 +1,12 @@
 #ifndef HEURISTIC_H
 #define HEURISTIC_H
 
+#include "evaluation_result.h"
 #include "evaluator.h"
 #include "operator_id.h"
 #include "per_state_information.h"
 #include "task_proxy.h"
 
-#include "algorithms/ordered_set.h"
-
 #include <memory>
 #include <vector>
 
@@ -32,17 +31,27 @@ class Heuristic : public Evaluator {
     static_assert(sizeof(HEntry) == 4, "HEntry has unexpected size.");
 
     /*
-      TODO: We might want to get rid of the preferred_operators
-      attribute. It is currently only used by compute_result() and the
-      methods it calls (compute_heuristic() directly, further methods
-      indirectly), and we could e.g. change this by having
-      compute_heuristic return an EvaluationResult object.
-
-      If we do this, we should be mindful of the cost incurred by not
-      being able to reuse the data structure from one iteration to the
-      next, but this seems to be the only potential downside.
+      The preferred operators of the last evaluation in the order in which
+      they were marked. The buffer is refilled for every evaluation and the
+      returned EvaluationResult only refers to it, so no memory is
+      allocated once the buffer has grown large enough. is_preferred is
+      indexed by operator ID and avoids duplicates.
+    */
+    PreferredOperatorsBuffer preferred_operators;
+    std::vector<bool> is_preferred;
+
+    void clear_preferred_operators();
+
+    /*
+      Estimates for the states of the last evaluation batch, which the
+      other states of the batch look up when they are evaluated.
     */
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
+    const StateRegistry *batch_registry;
+    std::vector<StateID> batch_state_ids;
+    std::vector<int> batch_values;
+
+    int compute_heuristic_in_batch(
+        const State &state, const std::vector<State> &batch);
 
 protected:
     /*
@@ -63,6 +72,21 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Heuristics that can compute the estimates for several states at once
+      faster than one after the other should override the two methods
+      below. compute_result uses batch evaluation for contexts with an
+      evaluation batch (see EvaluationContext) if no preferred operators
+      are requested. compute_heuristic_batch must set values[i] to the
+      estimate that compute_heuristic returns for ancestor_states[i].
+    */
+    virtual bool supports_batch_evaluation() const {
+        return false;
+    }
+
+    virtual void compute_heuristic_batch(
+        const std::vector<State> &ancestor_states, std::vector<int> &values);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
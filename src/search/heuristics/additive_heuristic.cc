@@ -2,6 +2,8 @@
 
 #include "../plugins/plugin.h"
 
+#include "../state_registry.h"
+
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
@@ -16,10 +18,36 @@ const int AdditiveHeuristic::MAX_COST_VALUE;
 // construction and destruction
 AdditiveHeuristic::AdditiveHeuristic(const plugins::Options &opts)
     : RelaxationHeuristic(opts),
-      did_write_overflow_warning(false) {
+      did_write_overflow_warning(false),
+      incremental(opts.get<bool>("incremental", false)),
+      max_affected_fraction(opts.get<double>("max_affected_fraction", 0.2)),
+      cache(incremental ? opts.get<int>("incremental_cache_size", 64) : 0),
+      cache_registry(nullptr),
+      num_cache_uses(0),
+      last_parent_id(StateID::no_state),
+      last_state_id(StateID::no_state),
+      num_cache_hits(0),
+      num_incremental_explorations(0),
+      num_full_explorations(0),
+      num_fallbacks(0) {
     if (log.is_at_least_normal()) {
         log << "Initializing additive heuristic..." << endl;
     }
+    if (incremental) {
+        int num_propositions = propositions.size();
+        achiever_starts.assign(num_propositions + 1, 0);
+        for (const UnaryOperator &op : unary_operators) {
+            ++achiever_starts[op.effect + 1];
+        }
+        for (int prop_id = 0; prop_id < num_propositions; ++prop_id) {
+            achiever_starts[prop_id + 1] += achiever_starts[prop_id];
+        }
+        achievers.resize(unary_operators.size());
+        vector<int> next_positions(achiever_starts.begin(), achiever_starts.end() - 1);
+        for (const UnaryOperator &op : unary_operators) {
+            achievers[next_positions[op.effect]++] = get_op_id(op);
+        }
+    }
 }
 
 void AdditiveHeuristic::write_overflow_warning() {
@@ -62,7 +90,7 @@ void AdditiveHeuristic::setup_exploration_queue_state(const State &state) {
     }
 }
 
-void AdditiveHeuristic::relaxed_exploration() {
+void AdditiveHeuristic::relaxed_exploration(bool compute_all_costs) {
     int unsolved_goals = goal_propositions.size();
     while (!queue.empty()) {
         pair<int, PropID> top_pair = queue.pop();
@@ -74,7 +102,7 @@ void AdditiveHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        if (prop->is_goal && --unsolved_goals == 0 && !compute_all_costs)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
@@ -115,10 +143,212 @@ void AdditiveHeuristic::mark_preferred_operators(
     }
 }
 
-int AdditiveHeuristic::compute_add_and_ff(const State &state) {
+void AdditiveHeuristic::compute_costs_from_scratch(
+    const State &state, bool compute_all_costs) {
     setup_exploration_queue();
     setup_exploration_queue_state(state);
-    relaxed_exploration();
+    relaxed_exploration(compute_all_costs);
+    ++num_full_explorations;
+}
+
+int AdditiveHeuristic::compute_operator_cost(OpID op_id) {
+    int cost = get_operator(op_id)->base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_proposition(precond)->cost;
+        if (precond_cost == -1)
+            return -1;
+        increase_cost(cost, precond_cost);
+    }
+    return cost;
+}
+
+bool AdditiveHeuristic::load_costs(StateID state_id) {
+    for (CachedExploration &entry : cache) {
+        if (entry.state_id == state_id) {
+            entry.last_use = ++num_cache_uses;
+            int num_propositions = propositions.size();
+            for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id) {
+                Proposition &prop = propositions[prop_id];
+                prop.cost = entry.costs[prop_id];
+                prop.reached_by = entry.reached_by[prop_id];
+                prop.marked = false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void AdditiveHeuristic::store_costs(StateID state_id) {
+    CachedExploration *oldest_entry = &cache.front();
+    for (CachedExploration &entry : cache) {
+        if (entry.last_use < oldest_entry->last_use)
+            oldest_entry = &entry;
+    }
+    CachedExploration &entry = *oldest_entry;
+    entry.state_id = state_id;
+    entry.last_use = ++num_cache_uses;
+    int num_propositions = propositions.size();
+    entry.costs.resize(num_propositions);
+    entry.reached_by.resize(num_propositions);
+    for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id) {
+        const Proposition &prop = propositions[prop_id];
+        entry.costs[prop_id] = prop.cost;
+        entry.reached_by[prop_id] = prop.reached_by;
+    }
+}
+
+/*
+  Turn the costs of the parent state into the costs of the state.
+
+  Facts of the parent that do not hold in the state lose their cost of 0,
+  which affects all propositions whose achievers (reached_by) depend on
+  these facts. We collect these propositions, which are the only ones
+  whose costs can increase, reset their costs and compute them again from
+  their achievers. Then we propagate the new and decreased costs, starting
+  with the facts that hold in the state but not in the parent, until no
+  cost decreases any more. Return false without completing the update if
+  too many propositions are affected.
+*/
+bool AdditiveHeuristic::update_costs(
+    const State &parent_state, const State &state) {
+    parent_state.unpack();
+    state.unpack();
+    const vector<int> &parent_values = parent_state.get_unpacked_values();
+    const vector<int> &values = state.get_unpacked_values();
+    int num_variables = values.size();
+
+    // We use the marked flags to mark the affected propositions.
+    affected_props.clear();
+    for (int var = 0; var < num_variables; ++var) {
+        if (parent_values[var] != values[var]) {
+            PropID prop_id = get_prop_id(var, parent_values[var]);
+            get_proposition(prop_id)->marked = true;
+            affected_props.push_back(prop_id);
+        }
+    }
+    size_t max_affected = max_affected_fraction * propositions.size();
+    for (size_t i = 0; i < affected_props.size(); ++i) {
+        const Proposition *prop = get_proposition(affected_props[i]);
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            PropID effect_id = get_operator(op_id)->effect;
+            Proposition *effect = get_proposition(effect_id);
+            if (effect->reached_by == op_id && effect->cost != -1 &&
+                !effect->marked) {
+                effect->marked = true;
+                affected_props.push_back(effect_id);
+            }
+        }
+        if (affected_props.size() > max_affected)
+            return false;
+    }
+
+    queue.clear();
+    for (PropID prop_id : affected_props) {
+        Proposition *prop = get_proposition(prop_id);
+        prop->cost = -1;
+        prop->reached_by = NO_OP;
+    }
+    for (int var = 0; var < num_variables; ++var) {
+        if (parent_values[var] != values[var])
+            enqueue_if_necessary(get_prop_id(var, values[var]), 0, NO_OP);
+    }
+    for (PropID prop_id : affected_props) {
+        Proposition *prop = get_proposition(prop_id);
+        prop->marked = false;
+        for (int i = achiever_starts[prop_id]; i < achiever_starts[prop_id + 1]; ++i) {
+            OpID op_id = achievers[i];
+            int op_cost = compute_operator_cost(op_id);
+            if (op_cost != -1)
+                enqueue_if_necessary(prop_id, op_cost, op_id);
+        }
+    }
+
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        const Proposition *prop = get_proposition(prop_id);
+        assert(prop->cost >= 0 && prop->cost <= distance);
+        if (prop->cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            // Skip operators that cannot lower the cost of their effect.
+            const UnaryOperator *unary_op = get_operator(op_id);
+            int effect_cost = get_proposition(unary_op->effect)->cost;
+            if (effect_cost != -1 &&
+                effect_cost <= prop->cost + unary_op->base_cost)
+                continue;
+            int op_cost = compute_operator_cost(op_id);
+            if (op_cost != -1)
+                enqueue_if_necessary(unary_op->effect, op_cost, op_id);
+        }
+    }
+    return true;
+}
+
+/*
+  Only complete explorations, i.e., ones that do not stop once all goals
+  are reached, are cached, since the incremental exploration needs the
+  costs of all propositions of the parent.
+*/
+void AdditiveHeuristic::compute_costs_incrementally(
+    const State &ancestor_state, const State &state) {
+    StateID state_id = ancestor_state.get_id();
+    const StateRegistry *registry = ancestor_state.get_registry();
+    if (state_id == StateID::no_state) {
+        // We cannot cache the costs of unregistered states.
+        compute_costs_from_scratch(state, false);
+        return;
+    }
+    if (registry != cache_registry) {
+        for (CachedExploration &entry : cache) {
+            entry.state_id = StateID::no_state;
+            entry.last_use = 0;
+        }
+        cache_registry = registry;
+        last_state_id = StateID::no_state;
+    }
+    if (load_costs(state_id)) {
+        ++num_cache_hits;
+        return;
+    }
+    if (state_id != last_state_id) {
+        // We do not know the parent (e.g., for the initial state).
+        compute_costs_from_scratch(state, true);
+        store_costs(state_id);
+        return;
+    }
+
+    State parent_state = convert_ancestor_state(
+        registry->lookup_state(last_parent_id));
+    if (!load_costs(last_parent_id)) {
+        /*
+          We compute the costs of the parent again if they are no longer
+          cached. This pays off if more successors of the parent follow,
+          as in eager search.
+        */
+        compute_costs_from_scratch(parent_state, true);
+        store_costs(last_parent_id);
+    }
+    if (update_costs(parent_state, state)) {
+        ++num_incremental_explorations;
+        store_costs(state_id);
+    } else {
+        ++num_fallbacks;
+        compute_costs_from_scratch(state, false);
+    }
+}
+
+int AdditiveHeuristic::compute_add_and_ff(
+    const State &ancestor_state, const State &state) {
+    if (incremental) {
+        compute_costs_incrementally(ancestor_state, state);
+    } else {
+        compute_costs_from_scratch(state, false);
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -133,7 +363,7 @@ int AdditiveHeuristic::compute_add_and_ff(const State &state) {
 
 int AdditiveHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int h = compute_add_and_ff(state);
+    int h = compute_add_and_ff(ancestor_state, state);
     if (h != DEAD_END) {
         for (PropID goal_id : goal_propositions)
             mark_preferred_operators(state, goal_id);
@@ -141,16 +371,88 @@ int AdditiveHeuristic::compute_heuristic(const State &ancestor_state) {
     return h;
 }
 
+void AdditiveHeuristic::compute_heuristic_batch(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    vector<State> states;
+    states.reserve(ancestor_states.size());
+    for (const State &ancestor_state : ancestor_states) {
+        states.push_back(convert_ancestor_state(ancestor_state));
+    }
+    get_batch_exploration(
+        relaxation_heuristic::BatchCostType::ADD, MAX_COST_VALUE)
+    .compute_goal_costs(states, values);
+    for (int h : values) {
+        if (h == MAX_COST_VALUE) {
+            write_overflow_warning();
+        }
+    }
+}
+
 void AdditiveHeuristic::compute_heuristic_for_cegar(const State &state) {
     compute_heuristic(state);
 }
 
+void AdditiveHeuristic::get_path_dependent_evaluators(set<Evaluator *> &evals) {
+    // The incremental exploration needs to know the parent of each state.
+    if (incremental)
+        evals.insert(this);
+}
+
+void AdditiveHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID, const State &state) {
+    /*
+      Search algorithms evaluate a state right after notifying us of the
+      transition to it, unless they notify us of several transitions at
+      once. In that case, only the last state can be computed
+      incrementally.
+    */
+    last_parent_id = parent_state.get_id();
+    last_state_id = state.get_id();
+}
+
+void AdditiveHeuristic::print_statistics() const {
+    if (incremental && log.is_at_least_normal()) {
+        log << "Incremental h^add explorations: " << num_incremental_explorations
+            << ", full explorations: " << num_full_explorations
+            << ", cache hits: " << num_cache_hits
+            << ", fallbacks on large changes: " << num_fallbacks << endl;
+    }
+}
+
+void AdditiveHeuristic::add_incremental_options_to_feature(
+    plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "incremental",
+        "compute the costs of the propositions for a successor state from "
+        "the costs for its parent by recomputing only the costs that depend "
+        "on the facts that differ between the two states. The costs of "
+        "recently evaluated states are kept for this purpose. The estimates "
+        "are the same as without this option, but h^FF and the preferred "
+        "operators can differ when several achievers have the same cost.",
+        "false");
+    feature.add_option<int>(
+        "incremental_cache_size",
+        "number of recently evaluated states whose proposition costs are "
+        "kept for the incremental computation",
+        "64",
+        plugins::Bounds("1", "infinity"));
+    feature.add_option<double>(
+        "max_affected_fraction",
+        "compute the costs from scratch if the costs of more than this "
+        "fraction of the propositions depend on parent facts that do not "
+        "hold in the successor",
+        "0.2",
+        plugins::Bounds("0.0", "1.0"));
+}
+
 class AdditiveHeuristicFeature : public plugins::TypedFeature<Evaluator, AdditiveHeuristic> {
 public:
     AdditiveHeuristicFeature() : TypedFeature("add") {
         document_title("Additive heuristic");
 
         Heuristic::add_options_to_feature(*this);
+        relaxation_heuristic::RelaxationHeuristic::add_batch_evaluation_option_to_feature(*this);
+        AdditiveHeuristic::add_incremental_options_to_feature(*this);
 
         document_language_support("action costs", "supported");
         document_language_support("conditional effects", "supported");
@@ -3,12 +3,16 @@
 
 #include "relaxation_heuristic.h"
 
+#include "../state_id.h"
+
 #include "../algorithms/priority_queues.h"
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <vector>
 
 class State;
+class StateRegistry;
 
 namespace additive_heuristic {
 using relaxation_heuristic::PropID;
@@ -29,12 +33,66 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
      */
     static const int MAX_COST_VALUE = 100000000;
 
+    /*
+      Proposition costs and achievers of a recently evaluated state, which
+      the incremental exploration uses as the starting point for the
+      successors of the state.
+    */
+    struct CachedExploration {
+        StateID state_id;
+        long last_use;
+        std::vector<int> costs;
+        std::vector<OpID> reached_by;
+
+        CachedExploration()
+            : state_id(StateID::no_state), last_use(0) {
+        }
+    };
+
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
+    const bool incremental;
+    const double max_affected_fraction;
+    /*
+      achievers[achiever_starts[p]] up to (excluding)
+      achievers[achiever_starts[p + 1]] are the unary operators with
+      effect p. Only built for the incremental exploration.
+    */
+    std::vector<int> achiever_starts;
+    std::vector<OpID> achievers;
+    /*
+      The cache holds few entries, so we look them up by a linear scan
+      and evict the least recently used entry when it is full. State IDs
+      are only meaningful for the registry of the cached states.
+    */
+    std::vector<CachedExploration> cache;
+    const StateRegistry *cache_registry;
+    long num_cache_uses;
+    // The transition of the last notification.
+    StateID last_parent_id;
+    StateID last_state_id;
+    std::vector<PropID> affected_props;
+
+    int num_cache_hits;
+    int num_incremental_explorations;
+    int num_full_explorations;
+    int num_fallbacks;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
-    void relaxed_exploration();
+    /*
+      If compute_all_costs is false, the exploration stops as soon as the
+      costs of all goals are known.
+    */
+    void relaxed_exploration(bool compute_all_costs);
+    void compute_costs_from_scratch(const State &state, bool compute_all_costs);
+    void compute_costs_incrementally(
+        const State &ancestor_state, const State &state);
+    bool update_costs(const State &parent_state, const State &state);
+    int compute_operator_cost(OpID op_id);
+    bool load_costs(StateID state_id);
+    void store_costs(StateID state_id);
     void mark_preferred_operators(const State &state, PropID goal_id);
 
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
@@ -61,12 +119,27 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     void write_overflow_warning();
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristic_batch(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 
-    // Common part of h^add and h^ff computation.
-    int compute_add_and_ff(const State &state);
+    /*
+      Common part of h^add and h^ff computation. The state must be the
+      result of converting the ancestor state.
+    */
+    int compute_add_and_ff(const State &ancestor_state, const State &state);
 public:
     explicit AdditiveHeuristic(const plugins::Options &opts);
 
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
+    virtual void print_statistics() const override;
+
+    static void add_incremental_options_to_feature(plugins::Feature &feature);
+
     /*
       TODO: The two methods below are temporarily needed for the CEGAR
       heuristic. In the long run it might be better to split the
@@ -0,0 +1,253 @@
+#include "batch_relaxed_exploration.h"
+
+#include "array_pool.h"
+#include "relaxation_heuristic.h"
+
+#include "../task_proxy.h"
+
+#include "../algorithms/sccs.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace relaxation_heuristic {
+using Lanes = array<int, BatchRelaxedExploration::NUM_LANES>;
+
+/*
+  Cost of unreached propositions. Sums of two costs that are at most
+  INFINITE_COST do not overflow.
+*/
+static const int INFINITE_COST = numeric_limits<int>::max() / 2;
+
+/*
+  The following functions process all lanes at once. They only use loops
+  of fixed length without branches, so that the compiler can vectorize
+  them.
+*/
+static inline void add_costs(Lanes &costs, const Lanes &other) {
+    for (size_t lane = 0; lane < costs.size(); ++lane) {
+        costs[lane] = min(costs[lane] + other[lane], INFINITE_COST);
+    }
+}
+
+static inline void maximize_costs(Lanes &costs, const Lanes &other) {
+    for (size_t lane = 0; lane < costs.size(); ++lane) {
+        costs[lane] = max(costs[lane], other[lane]);
+    }
+}
+
+// Add amount to all finite costs.
+static inline void add_to_finite_costs(Lanes &costs, int amount) {
+    for (size_t lane = 0; lane < costs.size(); ++lane) {
+        costs[lane] = min(costs[lane] + amount, INFINITE_COST);
+    }
+}
+
+// Clamp all finite costs to max_cost.
+static inline void clamp_finite_costs(Lanes &costs, int max_cost) {
+    for (size_t lane = 0; lane < costs.size(); ++lane) {
+        int clamped = min(costs[lane], max_cost);
+        costs[lane] = costs[lane] == INFINITE_COST ? INFINITE_COST : clamped;
+    }
+}
+
+// Lower costs to other where other is smaller and test if any cost changed.
+static inline bool minimize_costs(Lanes &costs, const Lanes &other) {
+    int lowered = 0;
+    for (size_t lane = 0; lane < costs.size(); ++lane) {
+        lowered |= other[lane] < costs[lane];
+        costs[lane] = min(costs[lane], other[lane]);
+    }
+    return lowered;
+}
+
+BatchRelaxedExploration::BatchRelaxedExploration(
+    BatchCostType cost_type, int max_cost,
+    const vector<PropID> &proposition_offsets,
+    int num_propositions,
+    const vector<PropID> &goal_propositions,
+    const vector<UnaryOperator> &unary_operators,
+    const array_pool::ArrayPool &preconditions_pool)
+    : cost_type(cost_type),
+      max_cost(max_cost),
+      proposition_offsets(proposition_offsets),
+      goal_propositions(goal_propositions),
+      proposition_costs(num_propositions),
+      proposition_changes(num_propositions, UNREACHED),
+      num_sweeps(0) {
+    assert(max_cost < INFINITE_COST);
+    int num_ops = unary_operators.size();
+    auto get_preconditions = [&](const UnaryOperator &op) {
+            return preconditions_pool.get_slice(
+                op.preconditions, op.num_preconditions);
+        };
+
+    vector<vector<int>> graph(num_propositions);
+    for (const UnaryOperator &op : unary_operators) {
+        for (PropID precondition : get_preconditions(op)) {
+            graph[precondition].push_back(op.effect);
+        }
+    }
+    vector<vector<int>> sccs = sccs::compute_maximal_sccs(graph);
+    vector<int> prop_to_scc(num_propositions);
+    for (size_t scc_id = 0; scc_id < sccs.size(); ++scc_id) {
+        for (PropID prop : sccs[scc_id]) {
+            prop_to_scc[prop] = scc_id;
+        }
+    }
+
+    // The SCCs are in topological order, so we sort the operators by them.
+    vector<int> op_order(num_ops);
+    iota(op_order.begin(), op_order.end(), 0);
+    stable_sort(op_order.begin(), op_order.end(),
+                [&](int op1, int op2) {
+                    return prop_to_scc[unary_operators[op1].effect] <
+                    prop_to_scc[unary_operators[op2].effect];
+                });
+
+    op_effects.reserve(num_ops);
+    op_base_costs.reserve(num_ops);
+    op_precondition_starts.reserve(num_ops + 1);
+    int last_scc = -1;
+    for (int pos = 0; pos < num_ops; ++pos) {
+        const UnaryOperator &op = unary_operators[op_order[pos]];
+        assert(op.base_cost >= 0 && op.base_cost < INFINITE_COST);
+        int scc = prop_to_scc[op.effect];
+        if (scc != last_scc) {
+            component_starts.push_back(pos);
+            component_is_cyclic.push_back(sccs[scc].size() > 1);
+            last_scc = scc;
+        }
+        op_effects.push_back(op.effect);
+        op_base_costs.push_back(op.base_cost);
+        op_precondition_starts.push_back(op_preconditions.size());
+        for (PropID precondition : get_preconditions(op)) {
+            op_preconditions.push_back(precondition);
+        }
+    }
+    op_precondition_starts.push_back(op_preconditions.size());
+    component_starts.push_back(num_ops);
+}
+
+void BatchRelaxedExploration::initialize_costs(
+    const vector<State> &states, int first_state) {
+    for (LaneCosts &prop_costs : proposition_costs) {
+        prop_costs.costs.fill(INFINITE_COST);
+    }
+    fill(proposition_changes.begin(), proposition_changes.end(), UNREACHED);
+    num_sweeps = 0;
+    int num_states = min<int>(NUM_LANES, states.size() - first_state);
+    for (int lane = 0; lane < num_states; ++lane) {
+        for (FactProxy fact : states[first_state + lane]) {
+            FactPair fact_pair = fact.get_pair();
+            PropID prop_id = proposition_offsets[fact_pair.var] + fact_pair.value;
+            proposition_costs[prop_id].costs[lane] = 0;
+            proposition_changes[prop_id] = 0;
+        }
+    }
+}
+
+bool BatchRelaxedExploration::needs_update(int op, int since_sweep) const {
+    int last_change = 0;
+    int preconditions_end = op_precondition_starts[op + 1];
+    for (int i = op_precondition_starts[op]; i < preconditions_end; ++i) {
+        int change = proposition_changes[op_preconditions[i]];
+        if (change == UNREACHED)
+            return false;
+        last_change = max(last_change, change);
+    }
+    return last_change >= since_sweep;
+}
+
+template<BatchCostType type>
+bool BatchRelaxedExploration::sweep(int first_op, int last_op, int since_sweep) {
+    int current_sweep = ++num_sweeps;
+    bool changed = false;
+    for (int op = first_op; op < last_op; ++op) {
+        if (!needs_update(op, since_sweep))
+            continue;
+        int base_cost = op_base_costs[op];
+        LaneCosts op_costs;
+        op_costs.costs.fill(type == BatchCostType::ADD ? base_cost : 0);
+        int preconditions_end = op_precondition_starts[op + 1];
+        for (int i = op_precondition_starts[op]; i < preconditions_end; ++i) {
+            const LaneCosts &precondition_costs =
+                proposition_costs[op_preconditions[i]];
+            if (type == BatchCostType::ADD) {
+                add_costs(op_costs.costs, precondition_costs.costs);
+            } else {
+                maximize_costs(op_costs.costs, precondition_costs.costs);
+            }
+        }
+        if (type == BatchCostType::ADD) {
+            clamp_finite_costs(op_costs.costs, max_cost);
+        } else {
+            add_to_finite_costs(op_costs.costs, base_cost);
+        }
+        PropID effect = op_effects[op];
+        if (minimize_costs(proposition_costs[effect].costs, op_costs.costs)) {
+            proposition_changes[effect] = current_sweep;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+template<BatchCostType type>
+void BatchRelaxedExploration::explore() {
+    int num_components = component_is_cyclic.size();
+    for (int component = 0; component < num_components; ++component) {
+        int first_op = component_starts[component];
+        int last_op = component_starts[component + 1];
+        /*
+          The first sweep updates all operators whose preconditions are
+          reached. Since the costs are updated in place, later sweeps only
+          need to update the operators with a precondition that changed in
+          the previous sweep (possibly after the operator was updated).
+        */
+        bool changed = sweep<type>(first_op, last_op, 0);
+        if (component_is_cyclic[component]) {
+            while (changed) {
+                changed = sweep<type>(first_op, last_op, num_sweeps);
+            }
+        }
+    }
+}
+
+int BatchRelaxedExploration::compute_goal_cost(int lane) const {
+    int total_cost = 0;
+    for (PropID goal : goal_propositions) {
+        int goal_cost = proposition_costs[goal].costs[lane];
+        if (goal_cost == INFINITE_COST)
+            return DEAD_END;
+        if (cost_type == BatchCostType::ADD) {
+            total_cost = min(total_cost + goal_cost, max_cost);
+        } else {
+            total_cost = max(total_cost, goal_cost);
+        }
+    }
+    return total_cost;
+}
+
+void BatchRelaxedExploration::compute_goal_costs(
+    const vector<State> &states, vector<int> &values) {
+    values.clear();
+    int num_states = states.size();
+    for (int first_state = 0; first_state < num_states; first_state += NUM_LANES) {
+        initialize_costs(states, first_state);
+        if (cost_type == BatchCostType::ADD) {
+            explore<BatchCostType::ADD>();
+        } else {
+            explore<BatchCostType::MAX>();
+        }
+        int num_lanes = min(NUM_LANES, num_states - first_state);
+        for (int lane = 0; lane < num_lanes; ++lane) {
+            values.push_back(compute_goal_cost(lane));
+        }
+    }
+}
+}
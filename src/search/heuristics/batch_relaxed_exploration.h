@@ -0,0 +1,113 @@
+#ifndef HEURISTICS_BATCH_RELAXED_EXPLORATION_H
+#define HEURISTICS_BATCH_RELAXED_EXPLORATION_H
+
+#include <array>
+#include <vector>
+
+class State;
+
+namespace array_pool {
+class ArrayPool;
+}
+
+namespace relaxation_heuristic {
+struct UnaryOperator;
+
+using PropID = int;
+
+enum class BatchCostType {
+    ADD,
+    MAX
+};
+
+/*
+  Compute h^add or h^max values for several states at once.
+
+  Instead of running a Dijkstra-style exploration for each state, we store
+  NUM_LANES costs per proposition next to each other (one "lane" per state)
+  and repeatedly sweep over the unary operators, lowering the effect costs
+  in all lanes at once (a generalized Bellman-Ford algorithm). The loops
+  over the lanes have a fixed length and no data-dependent branches, so the
+  compiler can unroll or vectorize them.
+
+  The unary operators are grouped by the strongly connected component of
+  the proposition graph (with arcs from preconditions to effects) that
+  contains their effect, and the components are swept in topological
+  order. Operators of components without cycles are swept once. The others
+  are swept until their costs no longer change. Sweeps skip operators with
+  a precondition that is unreached in all lanes and, except for the first
+  sweep of a component, operators whose preconditions did not change
+  since the previous sweep.
+
+  The result is the same as for the one-state explorations, including the
+  clamping of h^add costs to max_cost (which h^max does not use). Only
+  the goal costs are computed, so the search for preferred operators and
+  relaxed plans still needs the one-state explorations.
+*/
+class BatchRelaxedExploration {
+public:
+    static const int NUM_LANES = 8;
+    static const int DEAD_END = -1;
+
+private:
+    static const int UNREACHED = -1;
+
+    struct alignas(32) LaneCosts {
+        std::array<int, NUM_LANES> costs;
+    };
+
+    const BatchCostType cost_type;
+    const int max_cost;
+    std::vector<PropID> proposition_offsets;
+    std::vector<PropID> goal_propositions;
+
+    // Unary operators in sweep order, stored as a structure of arrays.
+    std::vector<PropID> op_effects;
+    std::vector<int> op_base_costs;
+    std::vector<int> op_precondition_starts;
+    std::vector<PropID> op_preconditions;
+
+    /*
+      The operators of the i-th component are those from position
+      component_starts[i] up to (excluding) component_starts[i + 1].
+    */
+    std::vector<int> component_starts;
+    std::vector<bool> component_is_cyclic;
+
+    std::vector<LaneCosts> proposition_costs;
+    /*
+      Number of the last sweep that lowered a cost of the proposition, 0
+      for the propositions of the states and UNREACHED if no cost of the
+      proposition is finite.
+    */
+    std::vector<int> proposition_changes;
+    int num_sweeps;
+
+    void initialize_costs(const std::vector<State> &states, int first_state);
+    bool needs_update(int op, int since_sweep) const;
+    template<BatchCostType type>
+    bool sweep(int first_op, int last_op, int since_sweep);
+    template<BatchCostType type>
+    void explore();
+    int compute_goal_cost(int lane) const;
+
+public:
+    BatchRelaxedExploration(
+        BatchCostType cost_type, int max_cost,
+        const std::vector<PropID> &proposition_offsets,
+        int num_propositions,
+        const std::vector<PropID> &goal_propositions,
+        const std::vector<UnaryOperator> &unary_operators,
+        const array_pool::ArrayPool &preconditions_pool);
+
+    /*
+      Set values[i] to the cost of the goal for states[i] or to DEAD_END
+      if the goal is unreachable. The states must belong to the task whose
+      unary operators were passed to the constructor.
+    */
+    void compute_goal_costs(
+        const std::vector<State> &states, std::vector<int> &values);
+};
+}
+
+#endif
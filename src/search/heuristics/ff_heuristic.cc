@@ -51,7 +51,7 @@ void FFHeuristic::mark_preferred_operators_and_relaxed_plan(
 
 int FFHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int h_add = compute_add_and_ff(state);
+    int h_add = compute_add_and_ff(ancestor_state, state);
     if (h_add == DEAD_END)
         return h_add;
 
@@ -75,6 +75,7 @@ public:
         document_title("FF heuristic");
 
         Heuristic::add_options_to_feature(*this);
+        additive_heuristic::AdditiveHeuristic::add_incremental_options_to_feature(*this);
 
         document_language_support("action costs", "supported");
         document_language_support("conditional effects", "supported");
@@ -1,7 +1,9 @@
 #include "lm_cut_heuristic.h"
 
 #include "lm_cut_landmarks.h"
+#include "lm_cut_storage.h"
 
+#include "../state_registry.h"
 #include "../task_proxy.h"
 
 #include "../plugins/plugin.h"
@@ -16,17 +18,76 @@ using namespace std;
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(const plugins::Options &opts)
     : Heuristic(opts),
-      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)),
+      reuse_parent_cuts(opts.get<bool>("reuse_parent_cuts", false)),
+      last_parent_id(StateID::no_state),
+      last_state_id(StateID::no_state),
+      last_op_id(-1),
+      num_cuts(0),
+      num_reused_cuts(0) {
     if (log.is_at_least_normal()) {
         log << "Initializing landmark cut heuristic..." << endl;
     }
+    if (reuse_parent_cuts) {
+        size_t max_memory_in_bytes =
+            static_cast<size_t>(opts.get<int>("cut_memory_limit", 256)) * 1024 * 1024;
+        cut_storage = utils::make_unique_ptr<CutStorage>(max_memory_in_bytes);
+    }
 }
 
 LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
+int LandmarkCutHeuristic::compute_heuristic_reusing_cuts(
+    const State &ancestor_state, const State &state) {
+    known_cuts.clear();
+    StateID state_id = ancestor_state.get_id();
+    if (state_id != StateID::no_state && state_id == last_state_id) {
+        /*
+          Every plan for the parent that starts with the operator leading
+          to the state uses an operator of each cut of the parent, so the
+          cuts that do not contain this operator are landmarks of the
+          state. We assume that the operators of the task of the heuristic
+          and of the search have the same IDs, which holds for the root
+          task and the tasks with adapted costs.
+        */
+        const StateRegistry *registry = ancestor_state.get_registry();
+        cut_storage->load_cuts_without_operator(
+            registry->lookup_state(last_parent_id), last_op_id, known_cuts);
+    }
+
+    int num_known_cuts = known_cuts.size();
+    int cut_index = 0;
+    int total_cost = 0;
+    cuts.clear();
+    bool dead_end = landmark_generator->compute_landmarks(
+        state,
+        nullptr,
+        [&](const vector<int> &cut, int cut_cost) {
+            // Known cuts whose operators became free are no longer cuts.
+            if (cut_cost > 0) {
+                total_cost += cut_cost;
+                cuts.push_back(cut);
+                ++num_cuts;
+                if (cut_index < num_known_cuts)
+                    ++num_reused_cuts;
+            }
+            ++cut_index;
+        },
+        known_cuts);
+
+    if (dead_end)
+        return DEAD_END;
+    if (state_id != StateID::no_state)
+        cut_storage->store_cuts(ancestor_state, cuts);
+    return total_cost;
+}
+
 int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
+    if (reuse_parent_cuts)
+        return compute_heuristic_reusing_cuts(ancestor_state, state);
+
     int total_cost = 0;
     bool dead_end = landmark_generator->compute_landmarks(
         state,
@@ -38,11 +99,53 @@ int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     return total_cost;
 }
 
+void LandmarkCutHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    // Reusing cuts needs to know the parent of each state.
+    if (reuse_parent_cuts)
+        evals.insert(this);
+}
+
+void LandmarkCutHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID op_id, const State &state) {
+    // As for h^add, only the cuts of the last notified parent are reused.
+    last_parent_id = parent_state.get_id();
+    last_state_id = state.get_id();
+    last_op_id = op_id.get_index();
+}
+
+void LandmarkCutHeuristic::print_statistics() const {
+    if (reuse_parent_cuts && log.is_at_least_normal()) {
+        double reused_fraction =
+            num_cuts ? static_cast<double>(num_reused_cuts) / num_cuts : 0.0;
+        log << "LM-cut cuts: " << num_cuts
+            << ", reused from parents: " << num_reused_cuts
+            << " (" << reused_fraction << ")" << endl;
+        cut_storage->print_statistics(log);
+    }
+}
+
 class LandmarkCutHeuristicFeature : public plugins::TypedFeature<Evaluator, LandmarkCutHeuristic> {
 public:
     LandmarkCutHeuristicFeature() : TypedFeature("lmcut") {
         document_title("Landmark-cut heuristic");
 
+        add_option<bool>(
+            "reuse_parent_cuts",
+            "store the cuts found for each state and start the computation "
+            "for a successor state with the cuts of its parent that do not "
+            "contain the operator leading to the successor. These cuts are "
+            "landmarks of the successor, so the estimates stay admissible, "
+            "but they depend on the parent through which a state is "
+            "reached and may differ from those without this option.",
+            "false");
+        add_option<int>(
+            "cut_memory_limit",
+            "maximal memory in MiB for the stored cuts. If the stored cuts "
+            "need more memory, the cuts of the states that were evaluated "
+            "first are discarded.",
+            "256",
+            plugins::Bounds("0", "infinity"));
         Heuristic::add_options_to_feature(*this);
 
         document_language_support("action costs", "supported");
@@ -4,21 +4,49 @@
 #include "../heuristic.h"
 
 #include <memory>
+#include <vector>
 
 namespace plugins {
 class Options;
 }
 
 namespace lm_cut_heuristic {
+class CutStorage;
 class LandmarkCutLandmarks;
 
 class LandmarkCutHeuristic : public Heuristic {
     std::unique_ptr<LandmarkCutLandmarks> landmark_generator;
 
+    /*
+      If cuts are reused, the cuts of each evaluated state are stored and
+      the cuts of the parent that do not contain the operator leading to
+      a state are landmarks of the state.
+    */
+    const bool reuse_parent_cuts;
+    std::unique_ptr<CutStorage> cut_storage;
+    // The transition of the last notification.
+    StateID last_parent_id;
+    StateID last_state_id;
+    int last_op_id;
+    std::vector<std::vector<int>> known_cuts;
+    std::vector<std::vector<int>> cuts;
+
+    long num_cuts;
+    long num_reused_cuts;
+
     virtual int compute_heuristic(const State &ancestor_state) override;
+    int compute_heuristic_reusing_cuts(
+        const State &ancestor_state, const State &state);
 public:
     explicit LandmarkCutHeuristic(const plugins::Options &opts);
     virtual ~LandmarkCutHeuristic() override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
+    virtual void print_statistics() const override;
 };
 }
 
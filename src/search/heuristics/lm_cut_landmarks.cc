@@ -9,22 +9,52 @@
 using namespace std;
 
 namespace lm_cut_heuristic {
+/*
+  Build the adjacency lists from propositions to the operators that have
+  them as preconditions (or effects), ordered by operator.
+*/
+static void build_reverse_lists(
+    int num_propositions, const vector<int> &op_starts,
+    const vector<int> &op_propositions, vector<int> &starts,
+    vector<int> &ops) {
+    starts.assign(num_propositions + 1, 0);
+    for (int prop : op_propositions)
+        ++starts[prop + 1];
+    for (int prop = 0; prop < num_propositions; ++prop)
+        starts[prop + 1] += starts[prop];
+    ops.resize(op_propositions.size());
+    vector<int> next_positions(starts.begin(), starts.end() - 1);
+    int num_ops = op_starts.size() - 1;
+    for (int op = 0; op < num_ops; ++op) {
+        for (int i = op_starts[op]; i < op_starts[op + 1]; ++i)
+            ops[next_positions[op_propositions[i]]++] = op;
+    }
+}
+
 // construction and destruction
-LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
+LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy)
+    : last_stamp(0),
+      state_stamp(0),
+      goal_zone_stamp(0),
+      before_goal_zone_stamp(0) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
 
     // Build propositions.
-    num_propositions = 2; // artificial goal and artificial precondition
     VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-        int var_id = fact.get_variable().get_id();
-        propositions[var_id].push_back(RelaxedProposition());
-        ++num_propositions;
+    proposition_offsets.reserve(variables.size());
+    PropID num_facts = 0;
+    for (VariableProxy var : variables) {
+        proposition_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
     }
+    artificial_precondition = num_facts;
+    artificial_goal = num_facts + 1;
+    int num_propositions = num_facts + 2;
 
     // Build relaxed operators for operators and axioms.
+    op_precondition_starts.push_back(0);
+    op_effect_starts.push_back(0);
     for (OperatorProxy op : task_proxy.get_operators())
         build_relaxed_operator(op);
 
@@ -35,150 +65,156 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
        unary operators hurts. */
 
     // Build artificial goal proposition and operator.
-    vector<RelaxedProposition *> goal_op_pre, goal_op_eff;
+    vector<PropID> goal_op_pre;
     for (FactProxy goal : task_proxy.get_goals()) {
-        goal_op_pre.push_back(get_proposition(goal));
+        goal_op_pre.push_back(get_prop_id(goal));
     }
-    goal_op_eff.push_back(&artificial_goal);
     /* Use the invalid operator ID -1 so accessing
        the artificial operator will generate an error. */
-    add_relaxed_operator(move(goal_op_pre), move(goal_op_eff), -1, 0);
+    add_relaxed_operator(move(goal_op_pre), {artificial_goal}, -1, 0);
 
     // Cross-reference relaxed operators.
-    for (RelaxedOperator &op : relaxed_operators) {
-        for (RelaxedProposition *pre : op.preconditions)
-            pre->precondition_of.push_back(&op);
-        for (RelaxedProposition *eff : op.effects)
-            eff->effect_of.push_back(&op);
-    }
+    build_reverse_lists(num_propositions, op_precondition_starts,
+                        op_preconditions, precondition_of_starts,
+                        precondition_of);
+    build_reverse_lists(num_propositions, op_effect_starts, op_effects,
+                        effect_of_starts, effect_of);
+
+    int num_ops = op_original_ids.size();
+    op_costs.resize(num_ops);
+    op_unsatisfied_preconditions.resize(num_ops);
+    op_h_max_supporters.resize(num_ops);
+    op_h_max_supporter_costs.resize(num_ops);
+    prop_h_max_costs.resize(num_propositions);
+    prop_stamps.resize(num_propositions, 0);
 }
 
 LandmarkCutLandmarks::~LandmarkCutLandmarks() {
 }
 
 void LandmarkCutLandmarks::build_relaxed_operator(const OperatorProxy &op) {
-    vector<RelaxedProposition *> precondition;
-    vector<RelaxedProposition *> effects;
+    vector<PropID> preconditions;
+    vector<PropID> effects;
     for (FactProxy pre : op.get_preconditions()) {
-        precondition.push_back(get_proposition(pre));
+        preconditions.push_back(get_prop_id(pre));
     }
     for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(get_proposition(eff.get_fact()));
+        effects.push_back(get_prop_id(eff.get_fact()));
     }
     add_relaxed_operator(
-        move(precondition), move(effects), op.get_id(), op.get_cost());
+        move(preconditions), move(effects), op.get_id(), op.get_cost());
 }
 
 void LandmarkCutLandmarks::add_relaxed_operator(
-    vector<RelaxedProposition *> &&precondition,
-    vector<RelaxedProposition *> &&effects,
+    vector<PropID> &&preconditions, vector<PropID> &&effects,
     int op_id, int base_cost) {
-    RelaxedOperator relaxed_op(
-        move(precondition), move(effects), op_id, base_cost);
-    if (relaxed_op.preconditions.empty())
-        relaxed_op.preconditions.push_back(&artificial_precondition);
-    relaxed_operators.push_back(relaxed_op);
+    if (preconditions.empty())
+        preconditions.push_back(artificial_precondition);
+    op_original_ids.push_back(op_id);
+    op_base_costs.push_back(base_cost);
+    op_num_preconditions.push_back(preconditions.size());
+    op_preconditions.insert(
+        op_preconditions.end(), preconditions.begin(), preconditions.end());
+    op_precondition_starts.push_back(op_preconditions.size());
+    op_effects.insert(op_effects.end(), effects.begin(), effects.end());
+    op_effect_starts.push_back(op_effects.size());
 }
 
-RelaxedProposition *LandmarkCutLandmarks::get_proposition(
-    const FactProxy &fact) {
-    int var_id = fact.get_variable().get_id();
-    int val = fact.get_value();
-    return &propositions[var_id][val];
+LandmarkCutLandmarks::PropID LandmarkCutLandmarks::get_prop_id(
+    const FactProxy &fact) const {
+    return proposition_offsets[fact.get_variable().get_id()] + fact.get_value();
 }
 
 // heuristic computation
-void LandmarkCutLandmarks::setup_exploration_queue() {
-    priority_queue.clear();
-
-    for (auto &var_props : propositions) {
-        for (RelaxedProposition &prop : var_props) {
-            prop.status = UNREACHED;
-        }
+void LandmarkCutLandmarks::start_new_state() {
+    /*
+      A state needs one stamp plus two stamps per cut. There are at most
+      as many cuts as operators because each cut reduces the cost of one
+      of its operators to 0 and only contains operators with positive
+      costs. Before the stamps can overflow, we reset them.
+    */
+    unsigned int max_stamps_per_state = 2 * op_costs.size() + 1;
+    if (last_stamp > numeric_limits<unsigned int>::max() - max_stamps_per_state) {
+        fill(prop_stamps.begin(), prop_stamps.end(), 0);
+        last_stamp = 0;
     }
+    state_stamp = ++last_stamp;
 
-    artificial_goal.status = UNREACHED;
-    artificial_precondition.status = UNREACHED;
-
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.unsatisfied_preconditions = op.preconditions.size();
-        op.h_max_supporter = 0;
-        op.h_max_supporter_cost = numeric_limits<int>::max();
-    }
+    copy(op_base_costs.begin(), op_base_costs.end(), op_costs.begin());
+    copy(op_num_preconditions.begin(), op_num_preconditions.end(),
+         op_unsatisfied_preconditions.begin());
+    fill(op_h_max_supporters.begin(), op_h_max_supporters.end(), NO_PROPOSITION);
 }
 
-void LandmarkCutLandmarks::setup_exploration_queue_state(const State &state) {
-    for (FactProxy init_fact : state) {
-        enqueue_if_necessary(get_proposition(init_fact), 0);
+void LandmarkCutLandmarks::setup_exploration_queue_state(
+    const vector<int> &state_values) {
+    int num_variables = state_values.size();
+    for (int var = 0; var < num_variables; ++var) {
+        enqueue_if_necessary(proposition_offsets[var] + state_values[var], 0);
     }
-    enqueue_if_necessary(&artificial_precondition, 0);
+    enqueue_if_necessary(artificial_precondition, 0);
 }
 
-void LandmarkCutLandmarks::first_exploration(const State &state) {
+void LandmarkCutLandmarks::first_exploration(const vector<int> &state_values) {
     assert(priority_queue.empty());
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
+    priority_queue.clear();
+    setup_exploration_queue_state(state_values);
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, PropID> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        PropID prop = top_pair.second;
+        int prop_cost = prop_h_max_costs[prop];
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            --relaxed_op->unsatisfied_preconditions;
-            assert(relaxed_op->unsatisfied_preconditions >= 0);
-            if (relaxed_op->unsatisfied_preconditions == 0) {
-                relaxed_op->h_max_supporter = prop;
-                relaxed_op->h_max_supporter_cost = prop_cost;
-                int target_cost = prop_cost + relaxed_op->cost;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    enqueue_if_necessary(effect, target_cost);
+        for (int i = precondition_of_starts[prop];
+             i < precondition_of_starts[prop + 1]; ++i) {
+            OpID op = precondition_of[i];
+            --op_unsatisfied_preconditions[op];
+            assert(op_unsatisfied_preconditions[op] >= 0);
+            if (op_unsatisfied_preconditions[op] == 0) {
+                op_h_max_supporters[op] = prop;
+                op_h_max_supporter_costs[op] = prop_cost;
+                int target_cost = prop_cost + op_costs[op];
+                for (int j = op_effect_starts[op]; j < op_effect_starts[op + 1]; ++j) {
+                    enqueue_if_necessary(op_effects[j], target_cost);
                 }
             }
         }
     }
 }
 
-void LandmarkCutLandmarks::first_exploration_incremental(
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::first_exploration_incremental() {
     assert(priority_queue.empty());
-    /* We pretend that this queue has had as many pushes already as we
-       have propositions to avoid switching from bucket-based to
-       heap-based too aggressively. This should prevent ever switching
-       to heap-based in problems where action costs are at most 1.
-    */
-    priority_queue.add_virtual_pushes(num_propositions);
-    for (RelaxedOperator *relaxed_op : cut) {
-        int cost = relaxed_op->h_max_supporter_cost + relaxed_op->cost;
-        for (RelaxedProposition *effect : relaxed_op->effects)
-            enqueue_if_necessary(effect, cost);
+    priority_queue.clear();
+    for (OpID op : cut) {
+        int cost = op_h_max_supporter_costs[op] + op_costs[op];
+        for (int j = op_effect_starts[op]; j < op_effect_starts[op + 1]; ++j)
+            enqueue_if_necessary(op_effects[j], cost);
     }
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, PropID> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        PropID prop = top_pair.second;
+        int prop_cost = prop_h_max_costs[prop];
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
-                int old_supp_cost = relaxed_op->h_max_supporter_cost;
+        for (int i = precondition_of_starts[prop];
+             i < precondition_of_starts[prop + 1]; ++i) {
+            OpID op = precondition_of[i];
+            if (op_h_max_supporters[op] == prop) {
+                int old_supp_cost = op_h_max_supporter_costs[op];
                 if (old_supp_cost > prop_cost) {
-                    relaxed_op->update_h_max_supporter();
-                    int new_supp_cost = relaxed_op->h_max_supporter_cost;
+                    update_h_max_supporter(op);
+                    int new_supp_cost = op_h_max_supporter_costs[op];
                     if (new_supp_cost != old_supp_cost) {
                         // This operator has become cheaper.
                         assert(new_supp_cost < old_supp_cost);
-                        int target_cost = new_supp_cost + relaxed_op->cost;
-                        for (RelaxedProposition *effect : relaxed_op->effects)
-                            enqueue_if_necessary(effect, target_cost);
+                        int target_cost = new_supp_cost + op_costs[op];
+                        for (int j = op_effect_starts[op];
+                             j < op_effect_starts[op + 1]; ++j)
+                            enqueue_if_necessary(op_effects[j], target_cost);
                     }
                 }
             }
@@ -186,43 +222,43 @@ void LandmarkCutLandmarks::first_exploration_incremental(
     }
 }
 
-void LandmarkCutLandmarks::second_exploration(
-    const State &state, vector<RelaxedProposition *> &second_exploration_queue,
-    vector<RelaxedOperator *> &cut) {
-    assert(second_exploration_queue.empty());
+void LandmarkCutLandmarks::second_exploration(const vector<int> &state_values) {
+    assert(proposition_stack.empty());
     assert(cut.empty());
 
-    artificial_precondition.status = BEFORE_GOAL_ZONE;
-    second_exploration_queue.push_back(&artificial_precondition);
+    prop_stamps[artificial_precondition] = before_goal_zone_stamp;
+    proposition_stack.push_back(artificial_precondition);
 
-    for (FactProxy init_fact : state) {
-        RelaxedProposition *init_prop = get_proposition(init_fact);
-        init_prop->status = BEFORE_GOAL_ZONE;
-        second_exploration_queue.push_back(init_prop);
+    int num_variables = state_values.size();
+    for (int var = 0; var < num_variables; ++var) {
+        PropID init_prop = proposition_offsets[var] + state_values[var];
+        prop_stamps[init_prop] = before_goal_zone_stamp;
+        proposition_stack.push_back(init_prop);
     }
 
-    while (!second_exploration_queue.empty()) {
-        RelaxedProposition *prop = second_exploration_queue.back();
-        second_exploration_queue.pop_back();
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
+    while (!proposition_stack.empty()) {
+        PropID prop = proposition_stack.back();
+        proposition_stack.pop_back();
+        for (int i = precondition_of_starts[prop];
+             i < precondition_of_starts[prop + 1]; ++i) {
+            OpID op = precondition_of[i];
+            if (op_h_max_supporters[op] == prop) {
                 bool reached_goal_zone = false;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    if (effect->status == GOAL_ZONE) {
-                        assert(relaxed_op->cost > 0);
+                for (int j = op_effect_starts[op]; j < op_effect_starts[op + 1]; ++j) {
+                    if (prop_stamps[op_effects[j]] == goal_zone_stamp) {
+                        assert(op_costs[op] > 0);
                         reached_goal_zone = true;
-                        cut.push_back(relaxed_op);
+                        cut.push_back(op);
                         break;
                     }
                 }
                 if (!reached_goal_zone) {
-                    for (RelaxedProposition *effect : relaxed_op->effects) {
-                        if (effect->status != BEFORE_GOAL_ZONE) {
-                            assert(effect->status == REACHED);
-                            effect->status = BEFORE_GOAL_ZONE;
-                            second_exploration_queue.push_back(effect);
+                    for (int j = op_effect_starts[op]; j < op_effect_starts[op + 1]; ++j) {
+                        PropID effect = op_effects[j];
+                        if (prop_stamps[effect] != before_goal_zone_stamp) {
+                            assert(is_reached(effect));
+                            prop_stamps[effect] = before_goal_zone_stamp;
+                            proposition_stack.push_back(effect);
                         }
                     }
                 }
@@ -231,16 +267,25 @@ void LandmarkCutLandmarks::second_exploration(
     }
 }
 
-void LandmarkCutLandmarks::mark_goal_plateau(RelaxedProposition *subgoal) {
-    // NOTE: subgoal can be null if we got here via recursion through
-    // a zero-cost action that is relaxed unreachable. (This can only
-    // happen in domains which have zero-cost actions to start with.)
-    // For example, this happens in pegsol-strips #01.
-    if (subgoal && subgoal->status != GOAL_ZONE) {
-        subgoal->status = GOAL_ZONE;
-        for (RelaxedOperator *achiever : subgoal->effect_of)
-            if (achiever->cost == 0)
-                mark_goal_plateau(achiever->h_max_supporter);
+void LandmarkCutLandmarks::mark_goal_plateau() {
+    assert(proposition_stack.empty());
+    proposition_stack.push_back(artificial_goal);
+    while (!proposition_stack.empty()) {
+        PropID subgoal = proposition_stack.back();
+        proposition_stack.pop_back();
+        if (prop_stamps[subgoal] == goal_zone_stamp)
+            continue;
+        prop_stamps[subgoal] = goal_zone_stamp;
+        for (int i = effect_of_starts[subgoal]; i < effect_of_starts[subgoal + 1]; ++i) {
+            OpID achiever = effect_of[i];
+            // NOTE: The supporter is missing if the achiever is a
+            // zero-cost action that is relaxed unreachable. (This can
+            // only happen in domains which have zero-cost actions to
+            // start with.) For example, this happens in pegsol-strips #01.
+            PropID supporter = op_h_max_supporters[achiever];
+            if (op_costs[achiever] == 0 && supporter != NO_PROPOSITION)
+                proposition_stack.push_back(supporter);
+        }
     }
 }
 
@@ -249,24 +294,26 @@ void LandmarkCutLandmarks::validate_h_max() const {
     // Using conditional compilation to avoid complaints about unused
     // variables when using NDEBUG. This whole code does nothing useful
     // when assertions are switched off anyway.
-    for (const RelaxedOperator &op : relaxed_operators) {
-        if (op.unsatisfied_preconditions) {
+    int num_ops = op_costs.size();
+    for (OpID op = 0; op < num_ops; ++op) {
+        if (op_unsatisfied_preconditions[op]) {
             bool reachable = true;
-            for (RelaxedProposition *pre : op.preconditions) {
-                if (pre->status == UNREACHED) {
+            for (int i = op_precondition_starts[op]; i < op_precondition_starts[op + 1]; ++i) {
+                if (!is_reached(op_preconditions[i])) {
                     reachable = false;
                     break;
                 }
             }
             assert(!reachable);
-            assert(!op.h_max_supporter);
+            assert(op_h_max_supporters[op] == NO_PROPOSITION);
         } else {
-            assert(op.h_max_supporter);
-            int h_max_cost = op.h_max_supporter_cost;
-            assert(h_max_cost == op.h_max_supporter->h_max_cost);
-            for (RelaxedProposition *pre : op.preconditions) {
-                assert(pre->status != UNREACHED);
-                assert(pre->h_max_cost <= h_max_cost);
+            assert(op_h_max_supporters[op] != NO_PROPOSITION);
+            int h_max_cost = op_h_max_supporter_costs[op];
+            assert(h_max_cost == prop_h_max_costs[op_h_max_supporters[op]]);
+            for (int i = op_precondition_starts[op]; i < op_precondition_starts[op + 1]; ++i) {
+                PropID pre = op_preconditions[i];
+                assert(is_reached(pre));
+                assert(prop_h_max_costs[pre] <= h_max_cost);
             }
         }
     }
@@ -275,64 +322,67 @@ void LandmarkCutLandmarks::validate_h_max() const {
 
 bool LandmarkCutLandmarks::compute_landmarks(
     const State &state, CostCallback cost_callback,
-    LandmarkCallback landmark_callback) {
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.cost = op.base_cost;
+    LandmarkCallback landmark_callback,
+    const vector<Landmark> &known_landmarks) {
+    state.unpack();
+    const vector<int> &state_values = state.get_unpacked_values();
+    start_new_state();
+    for (const Landmark &known_landmark : known_landmarks) {
+        // The operators of the task come first and keep their IDs.
+        assert(!known_landmark.empty());
+        int landmark_cost = numeric_limits<int>::max();
+        for (int op_id : known_landmark) {
+            assert(op_original_ids[op_id] == op_id);
+            landmark_cost = min(landmark_cost, op_costs[op_id]);
+        }
+        for (int op_id : known_landmark)
+            op_costs[op_id] -= landmark_cost;
+        if (cost_callback) {
+            cost_callback(landmark_cost);
+        }
+        if (landmark_callback) {
+            landmark_callback(known_landmark, landmark_cost);
+        }
     }
-    // The following three variables could be declared inside the loop
-    // ("second_exploration_queue" even inside second_exploration),
-    // but having them here saves reallocations and hence provides a
-    // measurable speed boost.
-    vector<RelaxedOperator *> cut;
-    Landmark landmark;
-    vector<RelaxedProposition *> second_exploration_queue;
-    first_exploration(state);
+    first_exploration(state_values);
     // validate_h_max();  // too expensive to use even in regular debug mode
-    if (artificial_goal.status == UNREACHED)
+    if (!is_reached(artificial_goal))
         return true;
 
     int num_iterations = 0;
-    while (artificial_goal.h_max_cost != 0) {
+    while (prop_h_max_costs[artificial_goal] != 0) {
         ++num_iterations;
-        mark_goal_plateau(&artificial_goal);
+        /*
+          Stamping the propositions with new stamps implicitly resets all
+          propositions in the goal zone or before the goal zone of the
+          previous cut to reached.
+        */
+        goal_zone_stamp = ++last_stamp;
+        before_goal_zone_stamp = ++last_stamp;
+        mark_goal_plateau();
         assert(cut.empty());
-        second_exploration(state, second_exploration_queue, cut);
+        second_exploration(state_values);
         assert(!cut.empty());
         int cut_cost = numeric_limits<int>::max();
-        for (RelaxedOperator *op : cut)
-            cut_cost = min(cut_cost, op->cost);
-        for (RelaxedOperator *op : cut)
-            op->cost -= cut_cost;
+        for (OpID op : cut)
+            cut_cost = min(cut_cost, op_costs[op]);
+        for (OpID op : cut)
+            op_costs[op] -= cut_cost;
 
         if (cost_callback) {
             cost_callback(cut_cost);
         }
         if (landmark_callback) {
             landmark.clear();
-            for (RelaxedOperator *op : cut) {
-                landmark.push_back(op->original_op_id);
+            for (OpID op : cut) {
+                landmark.push_back(op_original_ids[op]);
             }
             landmark_callback(landmark, cut_cost);
         }
 
-        first_exploration_incremental(cut);
+        first_exploration_incremental();
         // validate_h_max();  // too expensive to use even in regular debug mode
         cut.clear();
-
-        /*
-          Note: This could perhaps be made more efficient, for example by
-          using a round-dependent counter for GOAL_ZONE and BEFORE_GOAL_ZONE,
-          or something based on total_cost, so that we don't need a per-round
-          reinitialization.
-        */
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                    prop.status = REACHED;
-            }
-        }
-        artificial_goal.status = REACHED;
-        artificial_precondition.status = REACHED;
     }
     return false;
 }
@@ -11,76 +11,100 @@
 #include <vector>
 
 namespace lm_cut_heuristic {
-// TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
-
-enum PropositionStatus {
-    UNREACHED = 0,
-    REACHED = 1,
-    GOAL_ZONE = 2,
-    BEFORE_GOAL_ZONE = 3
-};
-
-struct RelaxedOperator {
-    int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
-    int base_cost; // 0 for axioms, 1 for regular operators
-
-    int cost;
-    int unsatisfied_preconditions;
-    int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base),
-          cost(-1), unsatisfied_preconditions(-1), h_max_supporter_cost(-1),
-          h_max_supporter(nullptr) {
-    }
-
-    inline void update_h_max_supporter();
-};
+/*
+  The relaxed operators and propositions are stored as a structure of
+  arrays. Operators and propositions are identified by their index in
+  these arrays. The last operator is the artificial goal operator, and
+  the propositions of the facts are followed by the artificial
+  precondition (of operators without preconditions) and the artificial
+  goal.
+
+  The status of a proposition (unreached, reached, in the goal zone or
+  before the goal zone) is encoded by stamping it with the number of the
+  state or of the cut in which it last changed (see compute_landmarks),
+  so the statuses do not have to be reset for each state and cut.
+*/
+class LandmarkCutLandmarks {
+    using PropID = int;
+    using OpID = int;
 
-struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
+    static const PropID NO_PROPOSITION = -1;
 
-    PropositionStatus status;
-    int h_max_cost;
-};
+    // TODO: Fix duplication with the other relaxation heuristics.
+    std::vector<int> op_original_ids;
+    std::vector<int> op_base_costs; // 0 for axioms, 1 for regular operators
+    std::vector<int> op_num_preconditions;
+    /*
+      The preconditions of operator op are op_preconditions[i] for
+      op_precondition_starts[op] <= i < op_precondition_starts[op + 1].
+      The other adjacency lists are stored in the same way.
+    */
+    std::vector<int> op_precondition_starts;
+    std::vector<PropID> op_preconditions;
+    std::vector<int> op_effect_starts;
+    std::vector<PropID> op_effects;
+
+    std::vector<int> op_costs;
+    std::vector<int> op_unsatisfied_preconditions;
+    std::vector<PropID> op_h_max_supporters;
+    std::vector<int> op_h_max_supporter_costs; // h_max_cost of h_max_supporter
+
+    // proposition_offsets[var]: PropID of the first fact of variable var.
+    std::vector<PropID> proposition_offsets;
+    PropID artificial_precondition;
+    PropID artificial_goal;
+    std::vector<int> precondition_of_starts;
+    std::vector<OpID> precondition_of;
+    std::vector<int> effect_of_starts;
+    std::vector<OpID> effect_of;
+
+    std::vector<int> prop_h_max_costs;
+    /*
+      A proposition is reached if its stamp is at least state_stamp. It is
+      in the goal zone or before the goal zone of the current cut if its
+      stamp is goal_zone_stamp or before_goal_zone_stamp, respectively.
+    */
+    std::vector<unsigned int> prop_stamps;
+    unsigned int last_stamp;
+    unsigned int state_stamp;
+    unsigned int goal_zone_stamp;
+    unsigned int before_goal_zone_stamp;
 
-class LandmarkCutLandmarks {
-    std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
-    int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
+    priority_queues::RadixHeap<PropID> priority_queue;
+    /*
+      Kept as members to save reallocations, which gives a measurable
+      speed boost.
+    */
+    std::vector<OpID> cut;
+    std::vector<int> landmark;
+    std::vector<PropID> proposition_stack;
 
     void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
+    void add_relaxed_operator(std::vector<PropID> &&preconditions,
+                              std::vector<PropID> &&effects,
                               int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
-    void setup_exploration_queue();
-    void setup_exploration_queue_state(const State &state);
-    void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
-    void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
-
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    PropID get_prop_id(const FactProxy &fact) const;
+    void start_new_state();
+    void setup_exploration_queue_state(const std::vector<int> &state_values);
+    void first_exploration(const std::vector<int> &state_values);
+    void first_exploration_incremental();
+    void second_exploration(const std::vector<int> &state_values);
+
+    bool is_reached(PropID prop) const {
+        return prop_stamps[prop] >= state_stamp;
+    }
+
+    void enqueue_if_necessary(PropID prop, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
+        if (!is_reached(prop) || prop_h_max_costs[prop] > cost) {
+            prop_stamps[prop] = state_stamp;
+            prop_h_max_costs[prop] = cost;
             priority_queue.push(cost, prop);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    void update_h_max_supporter(OpID op);
+    void mark_goal_plateau();
     void validate_h_max() const;
 public:
     using Landmark = std::vector<int>;
@@ -101,18 +125,34 @@ public:
       making a copy of the landmark, so cost_callback should be used if only the
       cost of the landmark is needed.
 
+      If known_landmarks is not empty, its elements must be landmarks of
+      the state, e.g., landmarks of a parent state that do not contain the
+      operator leading to the state. Before computing new landmarks, each
+      known landmark is assigned the minimal remaining cost of its
+      operators, which is then subtracted from them. The callbacks are
+      called for all known landmarks (even if their cost is 0) before they
+      are called for the new landmarks.
+
       Returns true iff state is detected as a dead end.
     */
     bool compute_landmarks(const State &state, CostCallback cost_callback,
-                           LandmarkCallback landmark_callback);
+                           LandmarkCallback landmark_callback,
+                           const std::vector<Landmark> &known_landmarks = {});
 };
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
+inline void LandmarkCutLandmarks::update_h_max_supporter(OpID op) {
+    assert(!op_unsatisfied_preconditions[op]);
+    PropID supporter = op_h_max_supporters[op];
+    int supporter_cost = prop_h_max_costs[supporter];
+    for (int i = op_precondition_starts[op]; i < op_precondition_starts[op + 1]; ++i) {
+        PropID precondition = op_preconditions[i];
+        if (prop_h_max_costs[precondition] > supporter_cost) {
+            supporter = precondition;
+            supporter_cost = prop_h_max_costs[precondition];
+        }
+    }
+    op_h_max_supporters[op] = supporter;
+    op_h_max_supporter_costs[op] = supporter_cost;
 }
 }
 
@@ -0,0 +1,137 @@
+#include "lm_cut_storage.h"
+
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+using namespace std;
+
+namespace lm_cut_heuristic {
+static const int WORD_BITS = 64;
+
+CutStorage::CutStorage(size_t max_memory_in_bytes)
+    : max_memory_in_bytes(max_memory_in_bytes),
+      slot_of_state(-1),
+      memory_in_bytes(0),
+      num_stored_states(0),
+      num_evicted_states(0) {
+}
+
+size_t CutStorage::get_memory_in_bytes(const Slot &slot) const {
+    return slot.data.capacity() * sizeof(Word);
+}
+
+void CutStorage::evict_oldest_slot() {
+    int slot_id = used_slots.front();
+    used_slots.pop_front();
+    Slot &slot = slots[slot_id];
+    memory_in_bytes -= get_memory_in_bytes(slot);
+    vector<Word>().swap(slot.data);
+    slot.registry = nullptr;
+    slot.state_id = StateID::no_state;
+    free_slots.push_back(slot_id);
+    ++num_evicted_states;
+}
+
+void CutStorage::store_cuts(
+    const State &state, const vector<vector<int>> &cuts) {
+    int &slot_id = slot_of_state[state];
+    if (slot_id == -1 || slots[slot_id].state_id != state.get_id() ||
+        slots[slot_id].registry != state.get_registry()) {
+        if (free_slots.empty()) {
+            slot_id = slots.size();
+            slots.emplace_back();
+        } else {
+            slot_id = free_slots.back();
+            free_slots.pop_back();
+        }
+        used_slots.push_back(slot_id);
+        ++num_stored_states;
+    }
+    Slot &slot = slots[slot_id];
+    memory_in_bytes -= get_memory_in_bytes(slot);
+    slot.registry = state.get_registry();
+    slot.state_id = state.get_id();
+
+    vector<Word> data;
+    vector<int> sorted_cut;
+    for (const vector<int> &cut : cuts) {
+        sorted_cut = cut;
+        sort(sorted_cut.begin(), sorted_cut.end());
+        size_t size_pos = data.size();
+        data.push_back(0);
+        for (int op_id : sorted_cut) {
+            Word word_index = op_id / WORD_BITS;
+            Word bit = Word(1) << (op_id % WORD_BITS);
+            if (data.size() > size_pos + 1 && data[data.size() - 2] == word_index) {
+                data.back() |= bit;
+            } else {
+                data.push_back(word_index);
+                data.push_back(bit);
+                ++data[size_pos];
+            }
+        }
+    }
+    slot.data.assign(data.begin(), data.end());
+    memory_in_bytes += get_memory_in_bytes(slot);
+
+    /*
+      The slot of the state is the most recently used one unless it was
+      filled before, so at least the cuts of the state survive.
+    */
+    while (memory_in_bytes > max_memory_in_bytes && used_slots.size() > 1 &&
+           used_slots.front() != slot_id) {
+        evict_oldest_slot();
+    }
+}
+
+bool CutStorage::load_cuts_without_operator(
+    const State &state, int op_id, vector<vector<int>> &cuts) const {
+    int slot_id = slot_of_state[state];
+    if (slot_id == -1)
+        return false;
+    const Slot &slot = slots[slot_id];
+    if (slot.state_id != state.get_id() ||
+        slot.registry != state.get_registry())
+        return false;
+
+    Word op_word_index = op_id / WORD_BITS;
+    Word op_bit = Word(1) << (op_id % WORD_BITS);
+    const vector<Word> &data = slot.data;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t num_words = data[pos];
+        size_t begin = pos + 1;
+        size_t end = begin + 2 * num_words;
+        pos = end;
+        bool contains_op = false;
+        for (size_t i = begin; i < end; i += 2) {
+            if (data[i] == op_word_index && (data[i + 1] & op_bit)) {
+                contains_op = true;
+                break;
+            }
+        }
+        if (contains_op)
+            continue;
+        cuts.emplace_back();
+        vector<int> &cut = cuts.back();
+        for (size_t i = begin; i < end; i += 2) {
+            int first_op_id = data[i] * WORD_BITS;
+            Word word = data[i + 1];
+            while (word) {
+                cut.push_back(first_op_id + countr_zero(word));
+                word &= word - 1;
+            }
+        }
+    }
+    return true;
+}
+
+void CutStorage::print_statistics(utils::LogProxy &log) const {
+    log << "States with stored cuts: " << num_stored_states
+        << ", evicted: " << num_evicted_states
+        << ", memory for cuts: " << memory_in_bytes / 1024 << " KB" << endl;
+}
+}
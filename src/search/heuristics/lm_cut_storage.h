@@ -0,0 +1,81 @@
+#ifndef HEURISTICS_LM_CUT_STORAGE_H
+#define HEURISTICS_LM_CUT_STORAGE_H
+
+#include "../per_state_information.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class State;
+class StateRegistry;
+
+namespace utils {
+class LogProxy;
+}
+
+namespace lm_cut_heuristic {
+/*
+  Store the LM-cut landmarks (cuts) found for states, so that they can be
+  reused for the successors of the states.
+
+  Each cut is stored as a compressed operator bitset, i.e., only the
+  non-zero 64-bit words of the bitset together with their indices. The
+  cuts of a state are kept in one of a number of slots, and a per-state
+  table maps each state to its slot. If storing the cuts of a state
+  exceeds the memory limit, the slots that were filled first are cleared
+  until the limit is respected again. Their states are not removed from
+  the table, but since each slot remembers its state, looking them up no
+  longer finds any cuts.
+*/
+class CutStorage {
+    using Word = std::uint64_t;
+
+    struct Slot {
+        const StateRegistry *registry;
+        StateID state_id;
+        /*
+          For each cut: the number n of its non-zero words, followed by n
+          pairs of a word index and the word.
+        */
+        std::vector<Word> data;
+
+        Slot()
+            : registry(nullptr), state_id(StateID::no_state) {
+        }
+    };
+
+    const size_t max_memory_in_bytes;
+    PerStateInformation<int> slot_of_state;
+    std::vector<Slot> slots;
+    std::vector<int> free_slots;
+    // Used slots in the order in which they were filled.
+    std::deque<int> used_slots;
+    size_t memory_in_bytes;
+
+    int num_stored_states;
+    int num_evicted_states;
+
+    size_t get_memory_in_bytes(const Slot &slot) const;
+    void evict_oldest_slot();
+public:
+    explicit CutStorage(size_t max_memory_in_bytes);
+
+    // Store the given cuts (lists of operator IDs) for the given state.
+    void store_cuts(const State &state,
+                    const std::vector<std::vector<int>> &cuts);
+
+    /*
+      Append the stored cuts of the given state that do not contain the
+      given operator to *cuts*. Return false if no cuts are stored for the
+      state.
+    */
+    bool load_cuts_without_operator(
+        const State &state, int op_id,
+        std::vector<std::vector<int>> &cuts) const;
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+}
+
+#endif
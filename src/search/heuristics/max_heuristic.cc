@@ -98,12 +98,24 @@ int HSPMaxHeuristic::compute_heuristic(const State &ancestor_state) {
     return total_cost;
 }
 
+void HSPMaxHeuristic::compute_heuristic_batch(
+    const vector<State> &ancestor_states, vector<int> &values) {
+    vector<State> states;
+    states.reserve(ancestor_states.size());
+    for (const State &ancestor_state : ancestor_states) {
+        states.push_back(convert_ancestor_state(ancestor_state));
+    }
+    get_batch_exploration(relaxation_heuristic::BatchCostType::MAX, 0)
+    .compute_goal_costs(states, values);
+}
+
 class HSPMaxHeuristicFeature : public plugins::TypedFeature<Evaluator, HSPMaxHeuristic> {
 public:
     HSPMaxHeuristicFeature() : TypedFeature("hmax") {
         document_title("Max heuristic");
 
         Heuristic::add_options_to_feature(*this);
+        relaxation_heuristic::RelaxationHeuristic::add_batch_evaluation_option_to_feature(*this);
 
         document_language_support("action costs", "supported");
         document_language_support("conditional effects", "supported");
@@ -6,6 +6,7 @@
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
+#include <vector>
 
 namespace max_heuristic {
 using relaxation_heuristic::PropID;
@@ -32,6 +33,9 @@ class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     }
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristic_batch(
+        const std::vector<State> &ancestor_states,
+        std::vector<int> &values) override;
 public:
     explicit HSPMaxHeuristic(const plugins::Options &opts);
 };
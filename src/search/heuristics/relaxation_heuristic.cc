@@ -1,8 +1,10 @@
 #include "relaxation_heuristic.h"
 
+#include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -36,7 +38,8 @@ UnaryOperator::UnaryOperator(
 
 // construction and destruction
 RelaxationHeuristic::RelaxationHeuristic(const plugins::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      use_batch_evaluation(opts.get<bool>("batch_evaluation", false)) {
     // Build propositions.
     propositions.resize(task_properties::get_num_facts(task_proxy));
 
@@ -96,6 +99,34 @@ bool RelaxationHeuristic::dead_ends_are_reliable() const {
     return !task_properties::has_axioms(task_proxy);
 }
 
+bool RelaxationHeuristic::supports_batch_evaluation() const {
+    return use_batch_evaluation;
+}
+
+BatchRelaxedExploration &RelaxationHeuristic::get_batch_exploration(
+    BatchCostType cost_type, int max_cost) {
+    if (!batch_exploration) {
+        batch_exploration = utils::make_unique_ptr<BatchRelaxedExploration>(
+            cost_type, max_cost, proposition_offsets, propositions.size(),
+            goal_propositions, unary_operators, preconditions_pool);
+    }
+    return *batch_exploration;
+}
+
+void RelaxationHeuristic::add_batch_evaluation_option_to_feature(
+    plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "batch_evaluation",
+        "compute the estimates of all new successors of an expanded state "
+        "at once if the search passes them as a batch (eager search with "
+        "batch_evaluation=true) and the heuristic is not used for "
+        "preferred operators. This gives the same estimates as computing "
+        "them one by one, but processes several states in each pass over "
+        "the unary operators, which is faster for tasks where most "
+        "propositions are reached from most states.",
+        "false");
+}
+
 PropID RelaxationHeuristic::get_prop_id(int var, int value) const {
     return proposition_offsets[var] + value;
 }
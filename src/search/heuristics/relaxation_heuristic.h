@@ -2,12 +2,14 @@
 #define HEURISTICS_RELAXATION_HEURISTIC_H
 
 #include "array_pool.h"
+#include "batch_relaxed_exploration.h"
 
 #include "../heuristic.h"
 
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <memory>
 #include <vector>
 
 class FactProxy;
@@ -60,6 +62,9 @@ class RelaxationHeuristic : public Heuristic {
 
     // proposition_offsets[var_no]: first PropID related to variable var_no
     std::vector<PropID> proposition_offsets;
+
+    const bool use_batch_evaluation;
+    std::unique_ptr<BatchRelaxedExploration> batch_exploration;
 protected:
     std::vector<UnaryOperator> unary_operators;
     std::vector<Proposition> propositions;
@@ -109,10 +114,19 @@ protected:
     const Proposition *get_proposition(int var, int value) const;
     Proposition *get_proposition(int var, int value);
     Proposition *get_proposition(const FactProxy &fact);
+
+    virtual bool supports_batch_evaluation() const override;
+
+    // Create the batch exploration on the first call.
+    BatchRelaxedExploration &get_batch_exploration(
+        BatchCostType cost_type, int max_cost);
 public:
     explicit RelaxationHeuristic(const plugins::Options &options);
 
     virtual bool dead_ends_are_reliable() const override;
+
+    static void add_batch_evaluation_option_to_feature(
+        plugins::Feature &feature);
 };
 }
 
@@ -0,0 +1,88 @@
+#include "cycle_pool.h"
+
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace landmarks {
+// Same tolerance as the Floyd-Warshall oracle.
+static const float epsilon = 0.001;
+
+CyclePool::CyclePool(int max_size)
+    : max_size(max_size),
+      num_lookups(0),
+      num_hits(0),
+      num_evictions(0) {
+    assert(max_size > 0);
+}
+
+bool CyclePool::is_violated(
+    const Entry &entry, const vector<float> &weights) const {
+    float weight = 0;
+    for (int id : entry.cycle) {
+        weight += weights[id];
+    }
+    return weight < entry.cycle.size() + 1.0 - epsilon;
+}
+
+vector<int> CyclePool::find_violated_cycle(
+    const vector<Word> &future_landmarks, const vector<float> &weights) {
+    ++num_lookups;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        bool applicable = all_of(
+            it->landmark_words.begin(), it->landmark_words.end(),
+            [&](const pair<int, Word> &word) {
+                return (future_landmarks[word.first] & word.second) == word.second;
+            });
+        if (applicable && is_violated(*it, weights)) {
+            ++num_hits;
+            entries.splice(entries.begin(), entries, it);
+            return it->cycle;
+        }
+    }
+    return {};
+}
+
+void CyclePool::insert(const vector<int> &cycle) {
+    vector<int> landmarks(cycle);
+    sort(landmarks.begin(), landmarks.end());
+    auto existing = entries_by_landmarks.find(landmarks);
+    if (existing != entries_by_landmarks.end()) {
+        entries.splice(entries.begin(), entries, existing->second);
+        return;
+    }
+
+    if (static_cast<int>(entries.size()) == max_size) {
+        vector<int> evicted(entries.back().cycle);
+        sort(evicted.begin(), evicted.end());
+        entries_by_landmarks.erase(evicted);
+        entries.pop_back();
+        ++num_evictions;
+    }
+
+    Entry entry;
+    entry.cycle = cycle;
+    for (int id : landmarks) {
+        int word_index = BitsetMath::word_index(id);
+        Word mask = BitsetMath::word_bit_mask(id);
+        if (!entry.landmark_words.empty()
+            && entry.landmark_words.back().first == word_index) {
+            entry.landmark_words.back().second |= mask;
+        } else {
+            entry.landmark_words.emplace_back(word_index, mask);
+        }
+    }
+    entries.push_front(move(entry));
+    entries_by_landmarks[move(landmarks)] = entries.begin();
+}
+
+void CyclePool::print_statistics(utils::LogProxy &log) const {
+    log << "Cycle pool size: " << entries.size() << endl;
+    log << "Cycle pool lookups: " << num_lookups << endl;
+    log << "Cycle pool hits: " << num_hits << endl;
+    log << "Cycle pool evictions: " << num_evictions << endl;
+}
+}
@@ -0,0 +1,63 @@
+#ifndef LANDMARKS_CYCLE_POOL_H
+#define LANDMARKS_CYCLE_POOL_H
+
+#include "../per_state_bitset.h"
+
+#include "../utils/hash.h"
+
+#include <list>
+#include <utility>
+#include <vector>
+
+namespace utils {
+class LogProxy;
+}
+
+namespace landmarks {
+/*
+  Landmark cycles found by a CycleOracle, kept across states so that they
+  can be reused without running the oracle again. A cycle applies to every
+  state in which all landmarks of the cycle are future landmarks, which is
+  tested against a bitset of these landmarks.
+
+  The pool holds at most max_size cycles and evicts the least recently
+  used cycle when it is full. Cycles are identified by their landmarks.
+*/
+class CyclePool {
+    using Word = BitsetMath::Word;
+
+    struct Entry {
+        std::vector<int> cycle;
+        // The landmarks of the cycle as pairs of word index and mask.
+        std::vector<std::pair<int, Word>> landmark_words;
+    };
+
+    const int max_size;
+    // Ordered from most to least recently used.
+    std::list<Entry> entries;
+    utils::HashMap<std::vector<int>, std::list<Entry>::iterator> entries_by_landmarks;
+
+    int num_lookups;
+    int num_hits;
+    int num_evictions;
+
+    bool is_violated(const Entry &entry, const std::vector<float> &weights) const;
+public:
+    explicit CyclePool(int max_size);
+
+    /*
+      Return a cycle whose landmarks are all set in *future_landmarks* and
+      whose cycle constraint is violated by the landmark weights, i.e., the
+      weights of its landmarks sum to less than the length of the cycle
+      plus one. Return an empty vector if there is no such cycle.
+    */
+    std::vector<int> find_violated_cycle(
+        const std::vector<Word> &future_landmarks,
+        const std::vector<float> &weights);
+    void insert(const std::vector<int> &cycle);
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+}
+
+#endif
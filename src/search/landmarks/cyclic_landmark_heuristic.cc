@@ -1,6 +1,6 @@
 #include "cyclic_landmark_heuristic.h"
 
-#include "dalm_graph.h"
+#include "dalm_compact_graph.h"
 
 #include "../operator_counting/constraint_generator.h"
 #include "../operator_counting/landmark_constraints.h"
@@ -8,6 +8,8 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/markup.h"
 
+#include <cmath>
+
 using namespace std;
 
 namespace landmarks {
@@ -16,9 +18,9 @@ CyclicLandmarkHeuristic::CyclicLandmarkHeuristic(const plugins::Options &opts)
       lp_solver(opts.get<lp::LPSolverType>("lpsolver")),
       ip(opts.get<bool>("use_integer_operator_counts")) {
     initialize(opts);
-    constraint_generators.emplace_back(
-        make_shared<operator_counting::LandmarkConstraints>(
-            opts, lm_graph, lm_status_manager));
+    landmark_constraints = make_shared<operator_counting::LandmarkConstraints>(
+        opts, lm_graph, lm_status_manager);
+    constraint_generators.push_back(landmark_constraints);
     for (auto &constraint_generator : opts.get_list<shared_ptr<operator_counting::ConstraintGenerator>>("additional_constraint_generators")) {
         /* FIXME: This is an ugly hack to avoid that the LM-Cut constraint
             generator is added in our dalai-opt-2023 alias... */
@@ -73,6 +75,21 @@ int CyclicLandmarkHeuristic::get_heuristic_value(const State &ancestor_state) {
     return result;
 }
 
+void CyclicLandmarkHeuristic::print_statistics() const {
+    DisjunctiveActionLandmarkHeuristic::print_statistics();
+    if (log.is_at_least_normal()) {
+        int num_solves = lp_solver.get_num_solves();
+        size_t num_iterations = lp_solver.get_num_simplex_iterations();
+        log << "LP solves: " << num_solves << endl;
+        log << "Simplex iterations: " << num_iterations << endl;
+        if (num_solves > 0) {
+            log << "Simplex iterations per LP solve: "
+                << static_cast<double>(num_iterations) / num_solves << endl;
+        }
+        landmark_constraints->print_statistics(log);
+    }
+}
+
 class CyclicLandmarkHeuristicFeature : public plugins::TypedFeature<Evaluator, CyclicLandmarkHeuristic> {
 public:
     CyclicLandmarkHeuristicFeature() : TypedFeature("cyclic") {
@@ -14,6 +14,7 @@ namespace landmarks {
 class CyclicLandmarkHeuristic : public DisjunctiveActionLandmarkHeuristic {
     lp::LPSolver lp_solver;
     const bool ip;
+    std::shared_ptr<operator_counting::LandmarkConstraints> landmark_constraints;
     std::vector<std::shared_ptr<operator_counting::ConstraintGenerator>> constraint_generators;
 
     void prepare_linear_program();
@@ -26,6 +27,8 @@ public:
 
     // TODO: Check if this makes sens.
     virtual bool dead_ends_are_reliable() const override {return true;};
+
+    virtual void print_statistics() const override;
 };
 }
 
@@ -0,0 +1,127 @@
+#include "dalm_compact_graph.h"
+
+#include "../utils/collections.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace landmarks {
+/*
+  Fill a CSR structure from a list of (row, value) pairs. The values of
+  each row end up sorted if the pairs are sorted by value.
+*/
+static void build_rows(int num_rows, const vector<pair<int, int>> &entries,
+                       vector<int> &offsets, vector<int> &data) {
+    offsets.assign(num_rows + 1, 0);
+    for (const pair<int, int> &entry : entries) {
+        ++offsets[entry.first + 1];
+    }
+    for (int row = 0; row < num_rows; ++row) {
+        offsets[row + 1] += offsets[row];
+    }
+    data.resize(entries.size());
+    vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (const pair<int, int> &entry : entries) {
+        data[next[entry.first]++] = entry.second;
+    }
+}
+
+CompactDisjunctiveActionLandmarkGraph::CompactDisjunctiveActionLandmarkGraph(
+    const DisjunctiveActionLandmarkGraph &graph, int num_operators)
+    : num_landmarks(graph.get_number_of_landmarks()),
+      num_operators(num_operators),
+      num_strong_orderings(graph.get_number_of_strong_orderings()),
+      num_weak_orderings(graph.get_number_of_weak_orderings()),
+      last_relevant_past_id(graph.get_last_relevant_past_id()),
+      uaa_landmarks(graph.has_uaa_landmarks()) {
+    /*
+      Landmarks are visited in increasing order and the action sets and
+      dependency maps are sorted, so all rows below end up sorted.
+    */
+    vector<pair<int, int>> lm_actions;
+    vector<pair<int, int>> op_landmarks;
+    vector<pair<int, int>> strong;
+    vector<pair<int, int>> weak;
+    vector<pair<int, int>> child_entries;
+    for (int id = 0; id < num_landmarks; ++id) {
+        for (int op_id : graph.get_actions(id)) {
+            assert(0 <= op_id && op_id < num_operators);
+            lm_actions.emplace_back(id, op_id);
+            op_landmarks.emplace_back(op_id, id);
+        }
+        for (const pair<const int, OrderingType> &dep : graph.get_dependencies(id)) {
+            if (dep.second == OrderingType::STRONG) {
+                strong.emplace_back(id, dep.first);
+            } else {
+                weak.emplace_back(id, dep.first);
+            }
+            child_entries.emplace_back(dep.first, id);
+        }
+        lm_true_in_initial.push_back(graph.is_true_in_initial(id));
+        lm_initially_fut.push_back(graph.is_initially_fut(id));
+    }
+    build_rows(num_landmarks, lm_actions, action_offsets, actions);
+    build_rows(num_operators, op_landmarks, landmark_offsets,
+               landmarks_by_operator);
+    build_rows(num_landmarks, strong, strong_parent_offsets, strong_parents);
+    build_rows(num_landmarks, weak, weak_parent_offsets, weak_parents);
+    build_rows(num_landmarks, child_entries, child_offsets, children);
+
+    for (const auto &entry : graph.get_goal_achiever_lms()) {
+        goal_achiever_lms.emplace_back(entry.first, entry.second);
+    }
+
+    precondition_fact_offsets.push_back(0);
+    for (const precondition_achiever_triple &entry :
+         graph.get_precondition_achiever_lms()) {
+        precondition_facts.insert(precondition_facts.end(),
+                                  entry.facts.begin(), entry.facts.end());
+        precondition_fact_offsets.push_back(precondition_facts.size());
+        precondition_achiever_lms.push_back(entry.achiever_lm);
+        preconditioned_lms.push_back(entry.preconditioned_lm);
+    }
+
+    if (uaa_landmarks) {
+        op_to_uaa_lm.reserve(num_operators);
+        for (int op_id = 0; op_id < num_operators; ++op_id) {
+            op_to_uaa_lm.push_back(graph.get_uaa_landmark_for_operator(op_id));
+        }
+    }
+}
+
+OrderingType CompactDisjunctiveActionLandmarkGraph::get_ordering_type(
+    int from, int to) const {
+    assert(0 <= from && from < num_landmarks);
+    assert(0 <= to && to < num_landmarks);
+    span<const int> weak_row = get_weak_parents(to);
+    if (binary_search(weak_row.begin(), weak_row.end(), from)) {
+        return OrderingType::WEAK;
+    }
+    assert(binary_search(get_strong_parents(to).begin(),
+                         get_strong_parents(to).end(), from));
+    return OrderingType::STRONG;
+}
+
+int CompactDisjunctiveActionLandmarkGraph::get_uaa_landmark_for_operator(
+    int op_id) const {
+    assert(utils::in_bounds(op_id, op_to_uaa_lm));
+    return op_to_uaa_lm[op_id];
+}
+
+size_t CompactDisjunctiveActionLandmarkGraph::estimate_memory_in_bytes() const {
+    size_t num_ints =
+        action_offsets.size() + actions.size() +
+        landmark_offsets.size() + landmarks_by_operator.size() +
+        strong_parent_offsets.size() + strong_parents.size() +
+        weak_parent_offsets.size() + weak_parents.size() +
+        child_offsets.size() + children.size() +
+        precondition_fact_offsets.size() + precondition_achiever_lms.size() +
+        preconditioned_lms.size() + op_to_uaa_lm.size();
+    return num_ints * sizeof(int) +
+           (lm_true_in_initial.size() + lm_initially_fut.size()) / 8 +
+           goal_achiever_lms.size() * sizeof(pair<FactPair, int>) +
+           precondition_facts.size() * sizeof(FactPair);
+}
+}
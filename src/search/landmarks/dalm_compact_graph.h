@@ -0,0 +1,139 @@
+#ifndef LANDMARKS_DALM_COMPACT_GRAPH_H
+#define LANDMARKS_DALM_COMPACT_GRAPH_H
+
+#include "dalm_graph.h"
+
+#include <span>
+#include <vector>
+
+namespace landmarks {
+/*
+  Read-only representation of a disjunctive action landmark graph that is
+  built once the landmark factory is done. All per-landmark and
+  per-operator information is stored in contiguous arrays in compressed
+  sparse row (CSR) format: the entries for index i are stored in the range
+  [offsets[i], offsets[i + 1]) of the corresponding data array.
+
+  Compared to DisjunctiveActionLandmarkGraph, which is optimized for
+  construction (sets, maps and the action-set index), this avoids pointer
+  chasing during heuristic evaluations and uses considerably less memory
+  for tasks with many operators.
+*/
+class CompactDisjunctiveActionLandmarkGraph {
+    int num_landmarks;
+    int num_operators;
+    size_t num_strong_orderings;
+    size_t num_weak_orderings;
+    int last_relevant_past_id;
+    bool uaa_landmarks;
+
+    // Sorted actions of each landmark.
+    std::vector<int> action_offsets;
+    std::vector<int> actions;
+    // Sorted landmarks achieved by each operator (inverse of the above).
+    std::vector<int> landmark_offsets;
+    std::vector<int> landmarks_by_operator;
+    // Sorted parents of each landmark, split by ordering type.
+    std::vector<int> strong_parent_offsets;
+    std::vector<int> strong_parents;
+    std::vector<int> weak_parent_offsets;
+    std::vector<int> weak_parents;
+    // Sorted children of each landmark regardless of the ordering type.
+    std::vector<int> child_offsets;
+    std::vector<int> children;
+
+    std::vector<bool> lm_true_in_initial;
+    std::vector<bool> lm_initially_fut;
+    std::vector<std::pair<FactPair, int>> goal_achiever_lms;
+    std::vector<int> precondition_fact_offsets;
+    std::vector<FactPair> precondition_facts;
+    std::vector<int> precondition_achiever_lms;
+    std::vector<int> preconditioned_lms;
+    std::vector<int> op_to_uaa_lm;
+
+    static std::span<const int> get_row(
+        const std::vector<int> &offsets, const std::vector<int> &data,
+        int index) {
+        return std::span<const int>(data.data() + offsets[index],
+                                    offsets[index + 1] - offsets[index]);
+    }
+public:
+    CompactDisjunctiveActionLandmarkGraph(
+        const DisjunctiveActionLandmarkGraph &graph, int num_operators);
+
+    size_t get_number_of_landmarks() const {
+        return num_landmarks;
+    }
+    int get_number_of_operators() const {
+        return num_operators;
+    }
+    size_t get_number_of_orderings() const {
+        return num_strong_orderings + num_weak_orderings;
+    }
+    size_t get_number_of_strong_orderings() const {
+        return num_strong_orderings;
+    }
+    size_t get_number_of_weak_orderings() const {
+        return num_weak_orderings;
+    }
+    size_t get_last_relevant_past_id() const {
+        return last_relevant_past_id;
+    }
+    bool has_uaa_landmarks() const {
+        return uaa_landmarks;
+    }
+
+    std::span<const int> get_actions(int id) const {
+        return get_row(action_offsets, actions, id);
+    }
+    std::span<const int> get_landmarks_achieved_by(int op_id) const {
+        return get_row(landmark_offsets, landmarks_by_operator, op_id);
+    }
+    std::span<const int> get_strong_parents(int id) const {
+        return get_row(strong_parent_offsets, strong_parents, id);
+    }
+    std::span<const int> get_weak_parents(int id) const {
+        return get_row(weak_parent_offsets, weak_parents, id);
+    }
+    std::span<const int> get_children(int id) const {
+        return get_row(child_offsets, children, id);
+    }
+    OrderingType get_ordering_type(int from, int to) const;
+
+    bool is_true_in_initial(int id) const {
+        return lm_true_in_initial[id];
+    }
+    bool is_initially_fut(int id) const {
+        return lm_initially_fut[id];
+    }
+    const std::vector<std::pair<FactPair, int>> &get_goal_achiever_lms() const {
+        return goal_achiever_lms;
+    }
+
+    /*
+      Precondition achievers are stored as parallel arrays indexed by the
+      number of the triple (see precondition_achiever_triple).
+    */
+    int get_number_of_precondition_achievers() const {
+        return precondition_achiever_lms.size();
+    }
+    std::span<const FactPair> get_precondition_facts(int index) const {
+        return std::span<const FactPair>(
+            precondition_facts.data() + precondition_fact_offsets[index],
+            precondition_fact_offsets[index + 1]
+            - precondition_fact_offsets[index]);
+    }
+    int get_precondition_achiever_lm(int index) const {
+        return precondition_achiever_lms[index];
+    }
+    int get_preconditioned_lm(int index) const {
+        return preconditioned_lms[index];
+    }
+
+    int get_uaa_landmark_for_operator(int op_id) const;
+
+    size_t estimate_memory_in_bytes() const;
+};
+}
+
+#endif
@@ -8,6 +8,8 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -19,7 +21,8 @@ using utils::ExitCode;
 namespace landmarks {
 DalmFactoryRhw::DalmFactoryRhw(const plugins::Options &opts)
     : LandmarkGraphFactory(),
-      max_preconditions(opts.get<int>("max_preconditions")) {
+      max_preconditions(opts.get<int>("max_preconditions")),
+      num_threads(opts.get<int>("num_threads")) {
 }
 
 void DalmFactoryRhw::build_dtg_successors(const TaskProxy &task_proxy) {
@@ -142,7 +145,7 @@ void DalmFactoryRhw::get_greedy_preconditions_for_lm(
 
 void DalmFactoryRhw::compute_shared_preconditions(
     const TaskProxy &task_proxy, unordered_map<int, int> &shared_pre,
-    set<int> &relevant_op_ids, const Landmark &landmark) {
+    const set<int> &relevant_op_ids, const Landmark &landmark) const {
     /*
       Compute the shared preconditions of all operators that can potentially
       achieve landmark bp, given the reachability in the relaxed planning graph.
@@ -232,7 +235,8 @@ void DalmFactoryRhw::build_disjunction_classes(const TaskProxy &task_proxy) {
 
 void DalmFactoryRhw::compute_disjunctive_preconditions(
     const TaskProxy &task_proxy, vector<set<FactPair>> &disjunctive_pre,
-    set<int> &relevant_op_ids, const Landmark &landmark, const unordered_map<int, int> &shared_pre) {
+    const set<int> &relevant_op_ids, const Landmark &landmark,
+    const unordered_map<int, int> &shared_pre) const {
     /*
       Compute disjunctive preconditions from all operators than can potentially
       achieve landmark bp, given the reachability in the relaxed planning graph.
@@ -347,11 +351,93 @@ void DalmFactoryRhw::add_nat_edge(int parent_index, int child_index) {
                          landmarks[child_index].first_achiever_dalm, true);
 }
 
+void DalmFactoryRhw::compute_backchaining_info(
+    const TaskProxy &task_proxy, const Landmark &landmark,
+    BackchainingInfo &info) const {
+    /*
+      Use the propositions that can be reached without achieving the
+      landmark to determine all operators that can possibly achieve
+      *landmark* for the first time.
+    */
+    for (const FactPair &lm_fact : landmark.facts) {
+        const vector<int> &op_ids = get_operators_including_eff(lm_fact);
+        for (int op_or_axiom_id : op_ids) {
+            if (possibly_reaches_lm(get_operator_or_axiom(task_proxy, op_or_axiom_id), info.reached, landmark)) {
+                info.first_achievers.insert(op_or_axiom_id);
+            }
+        }
+    }
+    /*
+      Collect any precondition propositions that all such operators share
+      (if there are any) and the disjunctive preconditions of the rest.
+    */
+    compute_shared_preconditions(task_proxy, info.shared_pre, info.first_achievers, landmark);
+    compute_disjunctive_preconditions(
+            task_proxy, info.disjunctive_pre, info.first_achievers, landmark,
+            info.shared_pre);
+}
+
+void DalmFactoryRhw::prefetch_backchaining_infos(
+    const TaskProxy &task_proxy, const State &initial_state,
+    vector<unique_ptr<Exploration>> &explorations) {
+    vector<int> landmark_indices;
+    for (int landmark_index : open_landmarks) {
+        if (!landmarks[landmark_index].fact_landmark.is_true_in_state(initial_state) &&
+            !prefetched_backchaining.count(landmark_index)) {
+            landmark_indices.push_back(landmark_index);
+        }
+    }
+
+    int num_landmarks = landmark_indices.size();
+    if (num_landmarks == 0) {
+        return;
+    }
+
+    /*
+      Each chunk of landmarks is explored in one batch exploration. Chunks
+      are made smaller than a full batch if that gives every thread work.
+    */
+    int num_workers = explorations.size();
+    int chunk_size = min(Exploration::NUM_LANES,
+                         (num_landmarks + num_workers - 1) / num_workers);
+    int num_chunks = (num_landmarks + chunk_size - 1) / chunk_size;
+    vector<BackchainingInfo> infos(num_landmarks);
+    utils::parallel_for(
+        num_chunks, num_workers,
+        [&](int worker_id, int chunk) {
+            int begin = chunk * chunk_size;
+            int end = min(begin + chunk_size, num_landmarks);
+            vector<vector<FactPair>> excluded_props;
+            for (int i = begin; i < end; ++i) {
+                excluded_props.push_back(
+                    landmarks[landmark_indices[i]].fact_landmark.facts);
+            }
+            vector<vector<vector<bool>>> reached =
+                explorations[worker_id]->compute_relaxed_reachability_batch(
+                    excluded_props, {});
+            for (int i = begin; i < end; ++i) {
+                infos[i].reached = move(reached[i - begin]);
+                compute_backchaining_info(
+                    task_proxy, landmarks[landmark_indices[i]].fact_landmark,
+                    infos[i]);
+            }
+        });
+
+    for (int i = 0; i < num_landmarks; ++i) {
+        prefetched_backchaining.emplace(landmark_indices[i], move(infos[i]));
+    }
+}
+
 std::shared_ptr<DisjunctiveActionLandmarkGraph> DalmFactoryRhw::compute_landmark_graph(
     const shared_ptr<AbstractTask> &task) {
     TaskProxy task_proxy(*task);
     dalm_graph = make_shared<DisjunctiveActionLandmarkGraph>(false, task_proxy);
-    Exploration exploration(task_proxy, utils::g_log);
+    vector<unique_ptr<Exploration>> explorations;
+    explorations.push_back(utils::make_unique_ptr<Exploration>(task_proxy, utils::g_log));
+    utils::LogProxy silent_log = utils::get_silent_log();
+    for (int i = 1; i < num_threads; ++i) {
+        explorations.push_back(utils::make_unique_ptr<Exploration>(task_proxy, silent_log));
+    }
 
     utils::g_log << "Generating landmarks with dalm rhw" << endl;
 
@@ -375,6 +461,15 @@ std::shared_ptr<DisjunctiveActionLandmarkGraph> DalmFactoryRhw::compute_landmark
 
     while (!open_landmarks.empty()) {
         int landmark_index = open_landmarks.front();
+        if (!landmarks[landmark_index].fact_landmark.is_true_in_state(initial_state) &&
+            !prefetched_backchaining.count(landmark_index)) {
+            /*
+              The infos only depend on the landmark, and landmarks are
+              processed in the order of open_landmarks either way, so
+              computing them in advance does not change the graph.
+            */
+            prefetch_backchaining_infos(task_proxy, initial_state, explorations);
+        }
         open_landmarks.pop_front();
         assert(forward_orders[landmark_index].empty());
 
@@ -382,36 +477,17 @@ std::shared_ptr<DisjunctiveActionLandmarkGraph> DalmFactoryRhw::compute_landmark
             /*
               Backchain from *landmark* and compute greedy necessary
               predecessors.
-              Firstly, collect which propositions can be reached without
-              achieving the landmark.
-            */
-            vector<int> excluded_op_ids;
-            vector<vector<bool>> reached =
-                    exploration.compute_relaxed_reachability(landmarks[landmark_index].fact_landmark.facts, excluded_op_ids);
-
-            set<int> first_achievers;
-            for (const FactPair &lm_fact : landmarks[landmark_index].fact_landmark.facts) {
-                const vector<int> &op_ids = get_operators_including_eff(lm_fact);
-                for (int op_or_axiom_id : op_ids) {
-                    if (possibly_reaches_lm(get_operator_or_axiom(task_proxy, op_or_axiom_id), reached, landmarks[landmark_index].fact_landmark)) {
-                        first_achievers.insert(op_or_axiom_id);
-                    }
-                }
-            }
-            add_first_achiever_dalm(landmark_index, first_achievers, initial_state);
-            /*
-              Use this information to determine all operators that can
-              possibly achieve *landmark* for the first time, and collect
-              any precondition propositions that all such operators share
-              (if there are any).
             */
-            unordered_map<int, int> shared_pre;
-            compute_shared_preconditions(task_proxy, shared_pre, first_achievers, landmarks[landmark_index].fact_landmark);
+            auto it = prefetched_backchaining.find(landmark_index);
+            assert(it != prefetched_backchaining.end());
+            BackchainingInfo info = move(it->second);
+            prefetched_backchaining.erase(it);
+            add_first_achiever_dalm(landmark_index, info.first_achievers, initial_state);
             /*
-              All such shared preconditions are landmarks, and greedy
-              necessary predecessors of *landmark*.
+              All shared preconditions of the first achievers are landmarks,
+              and greedy necessary predecessors of *landmark*.
             */
-            for (const auto &pre : shared_pre) {
+            for (const auto &pre : info.shared_pre) {
                 set<FactPair> pre_set({FactPair(pre.first, pre.second)});
                 int new_lm_index = add_landmark(pre_set, initial_state, landmark_index);
                 if (new_lm_index >= 0) {
@@ -420,14 +496,10 @@ std::shared_ptr<DisjunctiveActionLandmarkGraph> DalmFactoryRhw::compute_landmark
                 }
             }
             // Extract additional orders from the relaxed planning graph and DTG.
-            approximate_lookahead_orders(task_proxy, reached, landmark_index);
-
-            // Process achieving operators again to find disjunctive LMs
-            vector<set<FactPair>> disjunctive_pre;
-            compute_disjunctive_preconditions(
-                    task_proxy, disjunctive_pre, first_achievers, landmarks[landmark_index].fact_landmark,
-                    shared_pre);
-            for (const auto &preconditions : disjunctive_pre) {
+            approximate_lookahead_orders(task_proxy, info.reached, landmark_index);
+
+            // Add the disjunctive LMs found from the achieving operators.
+            for (const auto &preconditions : info.disjunctive_pre) {
                 // We don't want disjunctive LMs to get too big.
                 if (preconditions.size() <= max_preconditions) { // TODO make this an adjustable option
                     int new_lm_index = add_landmark(preconditions, initial_state, landmark_index);
@@ -655,6 +727,13 @@ public:
             "maximal numbers of common preconditions for achieving landmarks"
             "to continue searching for achievers.",
             "4");
+        add_option<int>(
+            "num_threads",
+            "number of threads running the relaxed explorations of open "
+            "landmarks concurrently. The resulting landmark graph is the same "
+            "for every number of threads.",
+            "1",
+            plugins::Bounds("1", "infinity"));
 
         document_language_support(
             "conditional_effects",
@@ -5,6 +5,7 @@
 
 #include "../plugins/options.h"
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -26,6 +27,20 @@ struct MixedLandmark {
 
 class DalmFactoryRhw : public LandmarkGraphFactory {
     const size_t max_preconditions;
+    const int num_threads;
+
+    /*
+      Everything the back-chaining step derives for a landmark from a relaxed
+      exploration that excludes it. It only depends on the facts of the landmark,
+      so it can be computed ahead of time and concurrently for the open landmarks.
+    */
+    struct BackchainingInfo {
+        std::vector<std::vector<bool>> reached;
+        std::set<int> first_achievers;
+        std::unordered_map<int, int> shared_pre;
+        std::vector<std::set<FactPair>> disjunctive_pre;
+    };
+
     std::shared_ptr<DisjunctiveActionLandmarkGraph> dalm_graph;
 
     std::vector<std::vector<std::vector<int>>> operators_eff_lookup;
@@ -36,6 +51,7 @@ class DalmFactoryRhw : public LandmarkGraphFactory {
     std::vector<MixedLandmark> landmarks;
     std::set<std::set<FactPair>> fact_lms;
     std::list<int> open_landmarks; //represents indices for landmarks vector
+    std::unordered_map<int, BackchainingInfo> prefetched_backchaining;
 
 //    std::vector<Landmark *> fact_lms;
 //    std::unordered_map<Landmark *, std::pair<int,int>> flm_to_dalm;
@@ -57,12 +73,24 @@ class DalmFactoryRhw : public LandmarkGraphFactory {
     void compute_shared_preconditions(
         const TaskProxy &task_proxy,
         std::unordered_map<int, int> &shared_pre,
-        std::set<int> &relevant_op_ids, const Landmark &landmark);
+        const std::set<int> &relevant_op_ids, const Landmark &landmark) const;
     void compute_disjunctive_preconditions(
         const TaskProxy &task_proxy,
         std::vector<std::set<FactPair>> &disjunctive_pre,
-        std::set<int> &relevant_op_ids,
-        const Landmark &landmark, const std::unordered_map<int, int> &shared_pre);
+        const std::set<int> &relevant_op_ids,
+        const Landmark &landmark, const std::unordered_map<int, int> &shared_pre) const;
+    // Complete *info* given the reachability in info.reached.
+    void compute_backchaining_info(
+        const TaskProxy &task_proxy, const Landmark &landmark,
+        BackchainingInfo &info) const;
+    /*
+      Compute the back-chaining information of all open landmarks that are
+      not true initially with batch explorations on num_threads threads,
+      one exploration per thread.
+    */
+    void prefetch_backchaining_infos(
+        const TaskProxy &task_proxy, const State &initial_state,
+        std::vector<std::unique_ptr<Exploration>> &explorations);
 
     std::shared_ptr<DisjunctiveActionLandmarkGraph> compute_landmark_graph(
         const std::shared_ptr<AbstractTask> &task) override;
@@ -111,7 +111,7 @@ public:
     std::vector<std::map<int, bool>> to_adj_list() const;
 
     void order_dalms_with_relevant_past_first();
-    size_t get_last_relevant_past_id() {
+    size_t get_last_relevant_past_id() const {
         return last_relevant_past_dalm;
     }
     bool has_uaa_landmarks() const {
@@ -1,12 +1,15 @@
 #include "dalm_greedy_hitting_set_heuristic.h"
 
-#include "dalm_graph.h"
+#include "dalm_compact_graph.h"
 #include "dalm_status_manager.h"
 
 #include "../plugins/plugin.h"
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
 
+#include <algorithm>
+#include <bit>
+
 using namespace std;
 
 namespace landmarks {
@@ -19,73 +22,99 @@ namespace landmarks {
                 << endl;
         }
         initialize(opts);
+        op_costs = task_properties::get_operator_costs(task_proxy);
         landmark_active = vector<bool>(lm_graph->get_number_of_landmarks(), false);
     }
 
-    int DisjunctiveActionLandmarkGreedyHittingSetHeuristic::get_heuristic_value(
+    /*
+      Collect the landmarks that are not past (i.e., future) in increasing
+      order. Returns false if one of them cannot be achieved.
+    */
+    bool DisjunctiveActionLandmarkGreedyHittingSetHeuristic::collect_active_landmarks(
             const State &ancestor_state) {
-        int max_hits = 0;
-        for (int id = 0; id < (int)landmark_active.size(); ++id) {
-            if (lm_status_manager->get_landmark_status(
-                    ancestor_state, id) != PAST) {
-                if (lm_graph->get_actions(id).size() == 0) {
-                    /* If the computation runs fully through all landmarks will be marked inactive and the op hits
-                     * will all be 0, but if we return here this is not the case, so we need to reset it manually.
-                     */
-                    fill(landmark_active.begin(), landmark_active.end(), false);
-                    fill(op_hits.begin(), op_hits.end(),0);
-                    return DEAD_END;
+        const BitsetView fut =
+            lm_status_manager->get_future_landmarks(ancestor_state);
+        int num_landmarks = static_cast<int>(landmark_active.size());
+        active_landmarks.clear();
+        for (int word = 0; word < fut.num_words(); ++word) {
+            BitsetMath::Word bits = fut.get_word(word);
+            while (bits) {
+                int id = word * BitsetMath::bits_per_word + countr_zero(bits);
+                bits &= bits - 1;
+                if (id >= num_landmarks) {
+                    break;
                 }
-                landmark_active[id] = true;
-                for (int op_id : lm_graph->get_actions(id)) {
-                    op_hits[op_id]++;
-                    if (op_hits[op_id] > max_hits) {
-                        max_hits = op_hits[op_id];
-                    }
+                if (lm_graph->get_actions(id).empty()) {
+                    return false;
                 }
-            } else {
-                landmark_active[id] = false;
+                active_landmarks.push_back(id);
             }
         }
-        if (max_hits == 0) {
-            return 0;
+        return true;
+    }
+
+    /*
+      Count how many active landmarks each operator hits. Only operators
+      with a positive count are touched, and they are collected in *hit_ops*
+      in increasing order. Returns the maximal number of hits.
+    */
+    int DisjunctiveActionLandmarkGreedyHittingSetHeuristic::count_op_hits() {
+        int max_hits = 0;
+        hit_ops.clear();
+        for (int id : active_landmarks) {
+            landmark_active[id] = true;
+            for (int op_id : lm_graph->get_actions(id)) {
+                if (op_hits[op_id]++ == 0) {
+                    hit_ops.push_back(op_id);
+                }
+                max_hits = max(max_hits, op_hits[op_id]);
+            }
         }
+        sort(hit_ops.begin(), hit_ops.end());
+        return max_hits;
+    }
 
-        vector<vector<int>> hits_to_op(max_hits);
-        for (vector<int> &elem : hits_to_op) {
-            elem.reserve(op_hits.size());
+    /*
+      Greedily choose the operator that hits the most active landmarks
+      until all landmarks are hit. The buckets in *hits_to_op* are updated
+      lazily: an operator whose number of hits decreased stays in its
+      bucket until it reaches the top, where it is moved down.
+    */
+    int DisjunctiveActionLandmarkGreedyHittingSetHeuristic::compute_greedy_hitting_set(
+            int max_hits) {
+        if (static_cast<int>(hits_to_op.size()) < max_hits) {
+            hits_to_op.resize(max_hits);
         }
-        for (size_t op_id = 0; op_id < op_hits.size(); ++op_id) {
-            if (op_hits[op_id] != 0) {
-                hits_to_op[op_hits[op_id]-1].push_back(op_id);
-            }
+        for (int op_id : hit_ops) {
+            hits_to_op[op_hits[op_id]-1].push_back(op_id);
         }
 
         int h = 0;
+        int top = max_hits - 1;
         while (true) {
             // Find op that hits max number of landmarks
             int chosen_op_id = -1;
             while (chosen_op_id  == -1) {
-                if (hits_to_op.back().empty()) {
-                    hits_to_op.pop_back();
-                    if (hits_to_op.empty()) {
+                vector<int> &bucket = hits_to_op[top];
+                if (bucket.empty()) {
+                    if (--top < 0) {
                         return h;
                     }
                     continue;
                 }
-                int op_id = hits_to_op.back().back();
+                int op_id = bucket.back();
                 int num_hits = op_hits[op_id];
-                if (num_hits == (int) hits_to_op.size()) {
+                if (num_hits == top + 1) {
                     chosen_op_id = op_id;
                 } else if (num_hits != 0) {
                     hits_to_op[num_hits-1].push_back(op_id);
                 }
-                hits_to_op.back().pop_back();
+                bucket.pop_back();
             }
 
-            h += task_proxy.get_operators()[chosen_op_id].get_cost();
+            h += op_costs[chosen_op_id];
             // Update active landmarks and operator hits
-            for (int lm_id : get_landmark_ids_for_operator(chosen_op_id)) {
+            for (int lm_id : lm_graph->get_landmarks_achieved_by(chosen_op_id)) {
                 if (landmark_active[lm_id]) {
                     for (int op_id : lm_graph->get_actions(lm_id)) {
                         op_hits[op_id]--;
@@ -94,7 +123,22 @@ namespace landmarks {
                 }
             }
         }
+    }
 
+    int DisjunctiveActionLandmarkGreedyHittingSetHeuristic::get_heuristic_value(
+            const State &ancestor_state) {
+        if (!collect_active_landmarks(ancestor_state)) {
+            return DEAD_END;
+        }
+        int max_hits = count_op_hits();
+        if (max_hits == 0) {
+            return 0;
+        }
+        /*
+          The greedy computation only ends once all active landmarks are
+          hit, so afterwards all operator hits are 0 again.
+        */
+        return compute_greedy_hitting_set(max_hits);
     }
 
     bool DisjunctiveActionLandmarkGreedyHittingSetHeuristic::dead_ends_are_reliable() const {
@@ -5,10 +5,24 @@
 
 namespace landmarks {
     class DisjunctiveActionLandmarkGreedyHittingSetHeuristic : public DisjunctiveActionLandmarkHeuristic {
-        std::vector<int> min_costs;
+        std::vector<int> op_costs;
         std::vector<bool> landmark_active;
         std::vector<int> op_hits;
 
+        /*
+          Buffers reused across evaluations so that computing the heuristic
+          does not allocate memory once they have reached their maximal size.
+          All entries of *op_hits* and *landmark_active* are zero (false) and
+          all buckets are empty between evaluations.
+        */
+        std::vector<int> active_landmarks;
+        std::vector<int> hit_ops;
+        std::vector<std::vector<int>> hits_to_op;
+
+        bool collect_active_landmarks(const State &ancestor_state);
+        int count_op_hits();
+        int compute_greedy_hitting_set(int max_hits);
+
         int get_heuristic_value(const State &ancestor_state) override;
     public:
         explicit DisjunctiveActionLandmarkGreedyHittingSetHeuristic(
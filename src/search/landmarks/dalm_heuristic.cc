@@ -1,5 +1,6 @@
 #include "dalm_heuristic.h"
 
+#include "dalm_compact_graph.h"
 #include "dalm_graph_factory.h"
 #include "dalm_status_manager.h"
 
@@ -15,6 +16,7 @@ DisjunctiveActionLandmarkHeuristic::DisjunctiveActionLandmarkHeuristic(
     const plugins::Options &opts)
     : Heuristic(opts),
       use_preferred_operators(opts.get<bool>("pref")),
+      intern_landmark_statuses(opts.get<bool>("intern_landmark_statuses")),
       successor_generator(nullptr) {
 }
 
@@ -33,10 +35,9 @@ void DisjunctiveActionLandmarkHeuristic::initialize(const plugins::Options &opts
     }
 
     compute_landmark_graph(opts);
-    precompute_landmarks_by_operator_lookup();
 
-    lm_status_manager =
-        make_shared<DisjunctiveActionLandmarkStatusManager>(*lm_graph);
+    lm_status_manager = make_shared<DisjunctiveActionLandmarkStatusManager>(
+        *lm_graph, task_proxy, intern_landmark_statuses);
         //utils::make_unique_ptr<DisjunctiveActionLandmarkStatusManager>(*lm_graph);
 
     if (use_preferred_operators) {
@@ -56,7 +57,10 @@ void DisjunctiveActionLandmarkHeuristic::compute_landmark_graph(
 
     auto lm_graph_factory =
         opts.get<shared_ptr<LandmarkGraphFactory>>("lm_factory");
-    lm_graph = lm_graph_factory->compute_landmark_graph(task);
+    shared_ptr<DisjunctiveActionLandmarkGraph> graph =
+        lm_graph_factory->compute_landmark_graph(task);
+    lm_graph = make_shared<CompactDisjunctiveActionLandmarkGraph>(
+        *graph, task_proxy.get_operators().size());
 
     if (log.is_at_least_normal()) {
         log << "Landmark graph generation time: " << lm_graph_timer << endl;
@@ -64,6 +68,8 @@ void DisjunctiveActionLandmarkHeuristic::compute_landmark_graph(
             << " landmarks." << endl;
         log << "Landmark graph contains " << lm_graph->get_number_of_orderings()
             << " orderings." << endl;
+        log << "Landmark graph representation uses approximately "
+            << lm_graph->estimate_memory_in_bytes() / 1024 << " KB." << endl;
     }
 }
 
@@ -78,7 +84,7 @@ void DisjunctiveActionLandmarkHeuristic::generate_preferred_operators(
     OperatorsProxy operators = task_proxy.get_operators();
     for (OperatorID op_id : applicable_operators) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        for (int lm_id : landmarks_by_operator[op.get_id()]) {
+        for (int lm_id : lm_graph->get_landmarks_achieved_by(op.get_id())) {
             if (lm_status_manager->get_future_landmarks(
                 ancestor_state).test(lm_id)) {
                 set_preferred(operators[op_id]);
@@ -100,18 +106,6 @@ int DisjunctiveActionLandmarkHeuristic::compute_heuristic(
     return h;
 }
 
-void DisjunctiveActionLandmarkHeuristic::precompute_landmarks_by_operator_lookup() {
-    int num_landmarks = static_cast<int>(lm_graph->get_number_of_landmarks());
-    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
-        for (auto op_id : lm_graph->get_actions(lm_id)) {
-            if (!landmarks_by_operator.count(op_id)) {
-                landmarks_by_operator[op_id] = {};
-            }
-            landmarks_by_operator[op_id].push_back(lm_id);
-        }
-    }
-}
-
 void DisjunctiveActionLandmarkHeuristic::notify_initial_state(
     const State &initial_state) {
     lm_status_manager->process_initial_state(initial_state, log);
@@ -127,6 +121,22 @@ void DisjunctiveActionLandmarkHeuristic::notify_state_transition(
     }
 }
 
+void DisjunctiveActionLandmarkHeuristic::notify_state_transitions(
+    const State &parent_state, const vector<OperatorID> &op_ids,
+    const vector<State> &states) {
+    lm_status_manager->process_state_transitions(parent_state, op_ids, states);
+    if (cache_evaluator_values) {
+        for (const State &state : states) {
+            heuristic_cache[state].dirty = true;
+        }
+    }
+}
+
+void DisjunctiveActionLandmarkHeuristic::print_statistics() const {
+    if (log.is_at_least_normal()) {
+        lm_status_manager->print_statistics(log);
+    }
+}
 
 void DisjunctiveActionLandmarkHeuristic::add_options_to_feature(plugins::Feature &feature) {
     feature.add_option<shared_ptr<LandmarkGraphFactory>>(
@@ -139,6 +149,13 @@ void DisjunctiveActionLandmarkHeuristic::add_options_to_feature(plugins::Feature
         "identify preferred operators (see OptionCaveats#"
         "Using_preferred_operators_with_landmark_heuristics)",
         "false");
+    feature.add_option<bool>(
+        "intern_landmark_statuses",
+        "store each distinct pair of past and future landmark sets only once "
+        "and only a handle to it per state. This saves memory if many states "
+        "share their landmark status, at the cost of a hash lookup per "
+        "state transition.",
+        "false");
 
     Heuristic::add_options_to_feature(feature);
 
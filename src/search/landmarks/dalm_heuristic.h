@@ -11,17 +11,21 @@ class SuccessorGenerator;
 
 namespace landmarks {
 class LandmarkGraphFactory;
-class DisjunctiveActionLandmarkGraph;
+class CompactDisjunctiveActionLandmarkGraph;
 class DisjunctiveActionLandmarkNode;
 class DisjunctiveActionLandmarkStatusManager;
 
 class DisjunctiveActionLandmarkHeuristic : public Heuristic {
     const bool use_preferred_operators;
+    const bool intern_landmark_statuses;
 
     std::shared_ptr<successor_generator::SuccessorGenerator> successor_generator;
-    std::unordered_map<int, std::vector<int>> landmarks_by_operator;
 protected:
-    std::shared_ptr<DisjunctiveActionLandmarkGraph> lm_graph;
+    /*
+      The graph computed by the landmark factory is only needed to build
+      this read-only representation and is discarded afterwards.
+    */
+    std::shared_ptr<CompactDisjunctiveActionLandmarkGraph> lm_graph;
 
     std::shared_ptr<DisjunctiveActionLandmarkStatusManager> lm_status_manager;
 
@@ -44,12 +48,6 @@ protected:
 
     void generate_preferred_operators(const State &state);
     virtual int compute_heuristic(const State &ancestor_state) override;
-
-    void precompute_landmarks_by_operator_lookup();
-
-    const std::vector<int> &get_landmark_ids_for_operator(int op_id) {
-        return landmarks_by_operator[op_id];
-    }
 public:
     explicit DisjunctiveActionLandmarkHeuristic(const plugins::Options &opts);
 
@@ -64,6 +62,11 @@ public:
     virtual void notify_state_transition(const State &parent_state,
                                          OperatorID op_id,
                                          const State &state) override;
+    virtual void notify_state_transitions(
+        const State &parent_state,
+        const std::vector<OperatorID> &op_ids,
+        const std::vector<State> &states) override;
+    virtual void print_statistics() const override;
 };
 }
 
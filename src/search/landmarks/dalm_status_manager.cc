@@ -1,7 +1,15 @@
 #include "dalm_status_manager.h"
 
+#include "dalm_status_pool.h"
 #include "landmark.h"
 
+#include "../state_registry.h"
+
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <bit>
+
 using namespace std;
 
 namespace landmarks {
@@ -10,27 +18,160 @@ namespace landmarks {
   computing new landmark information.
 */
 DisjunctiveActionLandmarkStatusManager::DisjunctiveActionLandmarkStatusManager(
-    DisjunctiveActionLandmarkGraph &graph)
+    const CompactDisjunctiveActionLandmarkGraph &graph,
+    const TaskProxy &task_proxy, bool intern_statuses)
     : lm_graph(graph),
       progress_uaa_landmarks(graph.has_uaa_landmarks()),
       past_lms(vector<bool>(graph.get_last_relevant_past_id()+1, true)),
-      future_lms(vector<bool>(graph.get_number_of_landmarks(), false)) {
+      future_lms(vector<bool>(graph.get_number_of_landmarks(), false)),
+      status_handles(-1),
+      num_states_with_status(0),
+      num_registered_states(0),
+      initial_state_id(StateID::no_state) {
+    if (intern_statuses) {
+        status_pool = utils::make_unique_ptr<DisjunctiveActionLandmarkStatusPool>(
+            vector<bool>(graph.get_last_relevant_past_id()+1, true),
+            vector<bool>(graph.get_number_of_landmarks(), false));
+    }
+    compute_achieved_words_by_operator();
+    compute_weak_successors();
+    compute_fact_indices(task_proxy);
+}
+
+DisjunctiveActionLandmarkStatusManager::~DisjunctiveActionLandmarkStatusManager() {
+}
+
+void DisjunctiveActionLandmarkStatusManager::compute_achieved_words_by_operator() {
+    int num_operators = lm_graph.get_number_of_operators();
+    achieved_words_by_operator.resize(num_operators);
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        // The landmarks of each operator are sorted, and so are the words.
+        auto &words = achieved_words_by_operator[op_id];
+        for (int lm_id : lm_graph.get_landmarks_achieved_by(op_id)) {
+            int word_index = BitsetMath::word_index(lm_id);
+            if (words.empty() || words.back().first != word_index) {
+                words.emplace_back(word_index, 0);
+            }
+            words.back().second |= BitsetMath::word_bit_mask(lm_id);
+        }
+    }
+}
+
+void DisjunctiveActionLandmarkStatusManager::compute_weak_successors() {
+    int num_landmarks = static_cast<int>(lm_graph.get_number_of_landmarks());
+    int num_past_landmarks =
+        static_cast<int>(lm_graph.get_last_relevant_past_id()) + 1;
+    has_weak_successors.assign(
+        BitsetMath::compute_num_words(num_past_landmarks), 0);
+    weak_successors.resize(num_past_landmarks);
+    for (int id = 0; id < num_landmarks; ++id) {
+        for (int parent : lm_graph.get_weak_parents(id)) {
+            assert(parent < num_past_landmarks);
+            has_weak_successors[BitsetMath::word_index(parent)] |=
+                BitsetMath::word_bit_mask(parent);
+            weak_successors[parent].push_back(id);
+        }
+    }
+}
+
+void DisjunctiveActionLandmarkStatusManager::compute_fact_indices(
+    const TaskProxy &task_proxy) {
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_variables = variables.size();
+    goal_achievers_by_var.resize(num_variables);
+    const auto &goal_achievers = lm_graph.get_goal_achiever_lms();
+    for (size_t i = 0; i < goal_achievers.size(); ++i) {
+        goal_achievers_by_var[goal_achievers[i].first.var].push_back(i);
+    }
+    precondition_achievers_by_var.resize(num_variables);
+    int num_triples = lm_graph.get_number_of_precondition_achievers();
+    for (int i = 0; i < num_triples; ++i) {
+        for (const FactPair &fact : lm_graph.get_precondition_facts(i)) {
+            vector<int> &triples = precondition_achievers_by_var[fact.var];
+            if (triples.empty() || triples.back() != i) {
+                triples.push_back(i);
+            }
+        }
+    }
+
+    int num_landmarks = static_cast<int>(lm_graph.get_number_of_landmarks());
+    goal_achievers_by_lm.resize(num_landmarks);
+    for (size_t i = 0; i < goal_achievers.size(); ++i) {
+        goal_achievers_by_lm[goal_achievers[i].second].push_back(i);
+    }
+    precondition_achievers_by_lm.resize(num_landmarks);
+    for (int i = 0; i < num_triples; ++i) {
+        precondition_achievers_by_lm[
+            lm_graph.get_precondition_achiever_lm(i)].push_back(i);
+    }
+
+    /*
+      Derived variables can change with every operator, so we consider
+      them affected by all operators.
+    */
+    vector<int> derived_vars;
+    for (VariableProxy var : variables) {
+        int var_id = var.get_id();
+        if (var.is_derived() && (!goal_achievers_by_var[var_id].empty()
+                                 || !precondition_achievers_by_var[var_id].empty())) {
+            derived_vars.push_back(var_id);
+        }
+    }
+    OperatorsProxy operators = task_proxy.get_operators();
+    affected_vars_by_operator.resize(operators.size());
+    for (OperatorProxy op : operators) {
+        vector<int> &vars = affected_vars_by_operator[op.get_id()];
+        for (EffectProxy effect : op.get_effects()) {
+            vars.push_back(effect.get_fact().get_variable().get_id());
+        }
+        vars.insert(vars.end(), derived_vars.begin(), derived_vars.end());
+        sort(vars.begin(), vars.end());
+        vars.erase(unique(vars.begin(), vars.end()), vars.end());
+    }
 }
 
 BitsetView DisjunctiveActionLandmarkStatusManager::get_past_landmarks(
     const State &state) {
+    if (status_pool) {
+        return status_pool->get_past(max(status_handles[state], 0));
+    }
     return past_lms[state];
 }
 
 BitsetView DisjunctiveActionLandmarkStatusManager::get_future_landmarks(
     const State &state) {
+    if (status_pool) {
+        return status_pool->get_future(max(status_handles[state], 0));
+    }
     return future_lms[state];
 }
 
+pair<BitsetView, BitsetView> DisjunctiveActionLandmarkStatusManager::begin_update(
+    const State &ancestor_state) {
+    if (status_pool) {
+        status_pool->load_scratch(max(status_handles[ancestor_state], 0));
+        return {status_pool->get_scratch_past(),
+                status_pool->get_scratch_future()};
+    }
+    return {past_lms[ancestor_state], future_lms[ancestor_state]};
+}
+
+void DisjunctiveActionLandmarkStatusManager::end_update(
+    const State &ancestor_state) {
+    num_registered_states = max(num_registered_states,
+                                ancestor_state.get_registry()->size());
+    if (status_pool) {
+        int &handle = status_handles[ancestor_state];
+        if (handle == -1) {
+            ++num_states_with_status;
+        }
+        handle = status_pool->intern_scratch();
+    }
+}
+
 void DisjunctiveActionLandmarkStatusManager::process_initial_state(
     const State &initial_state, utils::LogProxy &/*log*/) {
-    BitsetView past = get_past_landmarks(initial_state);
-    BitsetView future = get_future_landmarks(initial_state);
+    auto [past, future] = begin_update(initial_state);
     int num_landmarks = static_cast<int>(lm_graph.get_number_of_landmarks());
     for (int id = 0; id < num_landmarks; ++id) {
         assert(lm_graph.is_true_in_initial(id)
@@ -43,65 +184,101 @@ void DisjunctiveActionLandmarkStatusManager::process_initial_state(
         }
     }
     progress_weak(past, future);
+    end_update(initial_state);
+    initial_state_id = initial_state.get_id();
 }
 
 void DisjunctiveActionLandmarkStatusManager::process_state_transition(
     const State &parent_ancestor_state, OperatorID op_id,
     const State &ancestor_state) {
-
-    const BitsetView parent_past = get_past_landmarks(parent_ancestor_state);
-    BitsetView past = get_past_landmarks(ancestor_state);
-
-    const BitsetView parent_fut = get_future_landmarks(parent_ancestor_state);
-    BitsetView fut = get_future_landmarks(ancestor_state);
+    load_parent_words(parent_ancestor_state);
+    auto [past, fut] = begin_update(ancestor_state);
 
     int num_landmarks = static_cast<int>(lm_graph.get_number_of_landmarks());
     utils::unused_variable(num_landmarks);
     assert(past.size() == (int)lm_graph.get_last_relevant_past_id()+1);
-    assert(parent_past.size() == (int)lm_graph.get_last_relevant_past_id()+1);
     assert(fut.size() == num_landmarks);
-    assert(parent_fut.size() == num_landmarks);
 
-    progress_basic(parent_past, parent_fut, past, fut, op_id.get_index());
-    progress_goal(ancestor_state, fut);
-    progress_greedy_necessary(ancestor_state, past, fut);
+    progress_basic(past, fut, op_id.get_index());
+    progress_goal_and_greedy_necessary(
+        parent_ancestor_state, ancestor_state, op_id.get_index(), past, fut);
     progress_weak(past, fut);
-    if (progress_uaa_landmarks) {
-        int lm_index = lm_graph.get_uaa_landmark_for_operator(op_id.get_index());
-        if (lm_index >= 0) {
-            fut.set(lm_index);
-        }
+    progress_uaa(fut, op_id.get_index());
+    end_update(ancestor_state);
+}
+
+void DisjunctiveActionLandmarkStatusManager::process_state_transitions(
+    const State &parent_ancestor_state, const vector<OperatorID> &op_ids,
+    const vector<State> &ancestor_states) {
+    assert(op_ids.size() == ancestor_states.size());
+    if (op_ids.empty()) {
+        return;
+    }
+    load_parent_words(parent_ancestor_state);
+    for (size_t i = 0; i < op_ids.size(); ++i) {
+        int op_id = op_ids[i].get_index();
+        const State &ancestor_state = ancestor_states[i];
+        auto [past, fut] = begin_update(ancestor_state);
+        progress_basic(past, fut, op_id);
+        progress_goal_and_greedy_necessary(
+            parent_ancestor_state, ancestor_state, op_id, past, fut);
+        progress_weak(past, fut);
+        progress_uaa(fut, op_id);
+        end_update(ancestor_state);
+    }
+}
+
+void DisjunctiveActionLandmarkStatusManager::load_parent_words(
+    const State &parent_ancestor_state) {
+    /*
+      We copy the words because the views of the parent can be
+      invalidated when the statuses of its successors are stored.
+    */
+    const BitsetView parent_past = get_past_landmarks(parent_ancestor_state);
+    const BitsetView parent_fut = get_future_landmarks(parent_ancestor_state);
+    assert(parent_past.size() == (int)lm_graph.get_last_relevant_past_id()+1);
+    assert(parent_fut.size() == (int)lm_graph.get_number_of_landmarks());
+    parent_past_words.resize(parent_past.num_words());
+    for (int word = 0; word < parent_past.num_words(); ++word) {
+        parent_past_words[word] = parent_past.get_word(word);
+    }
+    parent_fut_words.resize(parent_fut.num_words());
+    for (int word = 0; word < parent_fut.num_words(); ++word) {
+        parent_fut_words[word] = parent_fut.get_word(word);
     }
 }
 
 void DisjunctiveActionLandmarkStatusManager::progress_basic(
-    const BitsetView &parent_past, const BitsetView &parent_fut,
     BitsetView &past, BitsetView &fut, int op_id) {
-
-    utils::unused_variable(parent_fut);
-    int num_landmarks = static_cast<int>(lm_graph.get_number_of_landmarks());
-
-    // TODO: Is there a more efficient way to do this?
-    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
-        /*
-         * We need to update the landmark information if the parent has "stronger" information
-         * (parent: only fut, child: only past/past and fut; or parent: past and fut, child: only past)
-         * and the landmark was not achieved in this transition (because otherwise the information would
-         * degenerate to "only past").
-         * In order to avoid calling count on the action set if possible, we first check for the "stronger" condition.
-         * Note that the condition can only fire if the landmark is fut in parent.
-         */
-        if (parent_fut.test(lm_id)) {
-            bool parent_fut_stronger = !fut.test(lm_id);
-            bool parent_past_stronger = (lm_id < past.size() && !parent_past.test(lm_id) && past.test(lm_id));
-            if ((parent_fut_stronger || parent_past_stronger) && lm_graph.get_actions(lm_id).count(op_id) == 0) {
-                if (parent_fut_stronger) {
-                    fut.set(lm_id);
-                }
-                if (parent_past_stronger) {
-                    past.reset(lm_id);
-                }
-            }
+    /*
+      We need to update the landmark information if the parent has
+      "stronger" information (parent: only fut, child: only past/past and
+      fut; or parent: past and fut, child: only past) and the landmark was
+      not achieved in this transition (because otherwise the information
+      would degenerate to "only past"). Both updates only concern
+      landmarks that are fut in the parent, so we compute them word by word
+      from the parent's future landmarks that are not achieved by *op_id*.
+    */
+    const vector<pair<int, BitsetMath::Word>> &achieved_words =
+        achieved_words_by_operator[op_id];
+    auto achieved_it = achieved_words.begin();
+    int num_past_words = past.num_words();
+    int num_words = fut.num_words();
+    for (int word = 0; word < num_words; ++word) {
+        BitsetMath::Word achieved = 0;
+        if (achieved_it != achieved_words.end()
+            && achieved_it->first == word) {
+            achieved = achieved_it->second;
+            ++achieved_it;
+        }
+        BitsetMath::Word not_achieved = parent_fut_words[word] & ~achieved;
+        if (!not_achieved) {
+            continue;
+        }
+        fut.set_word(word, fut.get_word(word) | not_achieved);
+        if (word < num_past_words) {
+            past.set_word(word, past.get_word(word)
+                          & ~(not_achieved & ~parent_past_words[word]));
         }
     }
 }
@@ -110,7 +287,7 @@ void DisjunctiveActionLandmarkStatusManager::progress_goal(
     const State &ancestor_state, BitsetView &fut) {
     for (const auto &entry : lm_graph.get_goal_achiever_lms()) {
         const FactPair &fact_pair = entry.first;
-        int lm_id = static_cast<int>(entry.second);
+        int lm_id = entry.second;
         // TODO: Does this check make sense?
         if (ancestor_state[fact_pair.var].get_value() != fact_pair.value) {
             fut.set(lm_id);
@@ -120,25 +297,116 @@ void DisjunctiveActionLandmarkStatusManager::progress_goal(
 
 void DisjunctiveActionLandmarkStatusManager::progress_greedy_necessary(
     const State &ancestor_state, const BitsetView &past, BitsetView &fut) {
-    for (const auto &entry : lm_graph.get_precondition_achiever_lms()) {
-        if (!past.test(static_cast<int>(entry.preconditioned_lm))
-            && none_of(entry.facts.begin(), entry.facts.end(),
-                       [ancestor_state](const FactPair &fact_pair) {
+    int num_entries = lm_graph.get_number_of_precondition_achievers();
+    for (int i = 0; i < num_entries; ++i) {
+        span<const FactPair> facts = lm_graph.get_precondition_facts(i);
+        if (!past.test(lm_graph.get_preconditioned_lm(i))
+            && none_of(facts.begin(), facts.end(),
+                       [&ancestor_state](const FactPair &fact_pair) {
+            return ancestor_state[fact_pair.var].get_value() == fact_pair.value;
+        })) {
+            fut.set(lm_graph.get_precondition_achiever_lm(i));
+        }
+    }
+}
+
+void DisjunctiveActionLandmarkStatusManager::progress_goal_and_greedy_necessary(
+    const State &parent_ancestor_state, const State &ancestor_state,
+    int op_id, const BitsetView &past, BitsetView &fut) {
+    if (parent_ancestor_state.get_id() == initial_state_id) {
+        progress_goal(ancestor_state, fut);
+        progress_greedy_necessary(ancestor_state, past, fut);
+    } else {
+        progress_triggered(parent_ancestor_state, ancestor_state, op_id,
+                           past, fut);
+    }
+}
+
+void DisjunctiveActionLandmarkStatusManager::progress_triggered(
+    const State &parent_ancestor_state, const State &ancestor_state,
+    int op_id, const BitsetView &past, BitsetView &fut) {
+    /*
+      This sets the same future landmarks as progress_goal and
+      progress_greedy_necessary, but only checks the goal achiever entries
+      and precondition achiever triples that a transition can trigger.
+
+      Consider an entry whose facts are not affected by *op_id* and whose
+      achiever landmark A is not achieved by it. If its check succeeds in
+      the child, it also succeeds in the parent because the facts are the
+      same. As the parent was reached by a transition, A is future in the
+      parent and hence in the child after progress_basic. For precondition
+      achiever triples, the check also requires that the preconditioned
+      landmark is not past in the child. If it is past in the parent, it
+      can only be non-past in the child because of an earlier transition
+      into the child, which set A already. This argument does not hold for
+      the initial state, whose statuses are not computed from the goal and
+      precondition checks.
+
+      We therefore only need to check entries with a fact on a variable
+      whose value differs between parent and child and entries whose
+      achiever landmark *op_id* achieves.
+    */
+    const auto &goal_achievers = lm_graph.get_goal_achiever_lms();
+    auto check_goal_achiever = [&](int i) {
+        const FactPair &fact_pair = goal_achievers[i].first;
+        if (ancestor_state[fact_pair.var].get_value() != fact_pair.value) {
+            fut.set(goal_achievers[i].second);
+        }
+    };
+    auto check_precondition_achiever = [&](int i) {
+        span<const FactPair> facts = lm_graph.get_precondition_facts(i);
+        if (!past.test(lm_graph.get_preconditioned_lm(i))
+            && none_of(facts.begin(), facts.end(),
+                       [&ancestor_state](const FactPair &fact_pair) {
             return ancestor_state[fact_pair.var].get_value() == fact_pair.value;
         })) {
-            fut.set(static_cast<int>(entry.achiever_lm));
+            fut.set(lm_graph.get_precondition_achiever_lm(i));
+        }
+    };
+
+    for (int var : affected_vars_by_operator[op_id]) {
+        if (ancestor_state[var].get_value()
+            == parent_ancestor_state[var].get_value()) {
+            continue;
+        }
+        for (int i : goal_achievers_by_var[var]) {
+            check_goal_achiever(i);
+        }
+        for (int i : precondition_achievers_by_var[var]) {
+            check_precondition_achiever(i);
+        }
+    }
+    for (int lm_id : lm_graph.get_landmarks_achieved_by(op_id)) {
+        for (int i : goal_achievers_by_lm[lm_id]) {
+            check_goal_achiever(i);
+        }
+        for (int i : precondition_achievers_by_lm[lm_id]) {
+            check_precondition_achiever(i);
+        }
+    }
+}
+
+void DisjunctiveActionLandmarkStatusManager::progress_uaa(
+    BitsetView &fut, int op_id) {
+    if (progress_uaa_landmarks) {
+        int lm_index = lm_graph.get_uaa_landmark_for_operator(op_id);
+        if (lm_index >= 0) {
+            fut.set(lm_index);
         }
     }
 }
 
 void DisjunctiveActionLandmarkStatusManager::progress_weak(
     const BitsetView &past, BitsetView &fut) {
-    int num_landmarks = static_cast<int>(lm_graph.get_number_of_landmarks());
-    for (int id = 0; id < num_landmarks; ++id) {
-        for (auto ordering : lm_graph.get_dependencies(id)) {
-            if (ordering.second == OrderingType::WEAK
-                && !past.test(ordering.first)) {
-                fut.set(id);
+    int num_words = past.num_words();
+    for (int word = 0; word < num_words; ++word) {
+        BitsetMath::Word not_past =
+            has_weak_successors[word] & ~past.get_word(word);
+        while (not_past) {
+            int id = word * BitsetMath::bits_per_word + countr_zero(not_past);
+            not_past &= not_past - 1;
+            for (int succ : weak_successors[id]) {
+                fut.set(succ);
             }
         }
     }
@@ -159,4 +427,24 @@ LandmarkStatus DisjunctiveActionLandmarkStatusManager::get_landmark_status(
         return FUTURE;
     }
 }
+
+void DisjunctiveActionLandmarkStatusManager::print_statistics(
+    utils::LogProxy &log) const {
+    size_t bytes_per_state =
+        (BitsetMath::compute_num_blocks(lm_graph.get_last_relevant_past_id() + 1)
+         + BitsetMath::compute_num_blocks(lm_graph.get_number_of_landmarks()))
+        * sizeof(BitsetMath::Block);
+    size_t per_state_bytes = num_registered_states * bytes_per_state;
+    log << "Landmark statuses without interning: "
+        << per_state_bytes / 1024 << " KB (" << bytes_per_state
+        << " bytes per state)." << endl;
+    if (status_pool) {
+        size_t interned_bytes = num_registered_states * sizeof(int)
+            + status_pool->estimate_memory_in_bytes();
+        log << "Interned landmark statuses: " << status_pool->size()
+            << " distinct for " << num_states_with_status << " states." << endl;
+        log << "Interned landmark statuses use " << interned_bytes / 1024
+            << " KB." << endl;
+    }
+}
 }
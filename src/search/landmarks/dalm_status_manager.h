@@ -1,33 +1,101 @@
 #ifndef LANDMARKS_LANDMARK_STATUS_MANAGER_H
 #define LANDMARKS_LANDMARK_STATUS_MANAGER_H
 
-#include "dalm_graph.h"
+#include "dalm_compact_graph.h"
 
 #include "../per_state_bitset.h"
+#include "../per_state_information.h"
+
+#include <memory>
+#include <vector>
 
 namespace landmarks {
+class DisjunctiveActionLandmarkStatusPool;
 class LandmarkGraph;
 class LandmarkNode;
 
 enum LandmarkStatus {PAST = 0, FUTURE = 1, PAST_AND_FUTURE = 2};
 
 class DisjunctiveActionLandmarkStatusManager {
-    DisjunctiveActionLandmarkGraph &lm_graph;
+    const CompactDisjunctiveActionLandmarkGraph &lm_graph;
     const bool progress_uaa_landmarks;
 
     PerStateBitset past_lms;
     PerStateBitset future_lms;
 
-    void progress_basic(
-        const BitsetView &parent_past, const BitsetView &parent_fut,
-        BitsetView &past, BitsetView &fut, int op_id);
+    /*
+      If landmark statuses are interned, states only store a handle into
+      *status_pool* and *past_lms* and *future_lms* are unused. Handle -1
+      marks states without status; they use the default entry.
+    */
+    std::unique_ptr<DisjunctiveActionLandmarkStatusPool> status_pool;
+    PerStateInformation<int> status_handles;
+    int num_states_with_status;
+    std::size_t num_registered_states;
+
+    /*
+      For each operator, the words of the future bitset in which the
+      operator achieves at least one landmark, stored sparsely as pairs of
+      word index and mask and sorted by word index.
+    */
+    std::vector<std::vector<std::pair<int, BitsetMath::Word>>>
+    achieved_words_by_operator;
+    /*
+      Landmarks in the past bitset that have weak successors as a bitmask
+      over the words of the past bitset, together with these successors.
+    */
+    std::vector<BitsetMath::Word> has_weak_successors;
+    std::vector<std::vector<int>> weak_successors;
+
+    /*
+      Triggers for the goal and precondition checks of a transition (see
+      progress_triggered). Goal achiever entries and precondition achiever
+      triples are indexed by the variables of their facts and by their
+      achiever landmark.
+    */
+    std::vector<std::vector<int>> affected_vars_by_operator;
+    std::vector<std::vector<int>> goal_achievers_by_var;
+    std::vector<std::vector<int>> precondition_achievers_by_var;
+    std::vector<std::vector<int>> goal_achievers_by_lm;
+    std::vector<std::vector<int>> precondition_achievers_by_lm;
+
+    // Transitions from the initial state are progressed without triggers.
+    StateID initial_state_id;
+
+    // Scratch space for progressing the statuses of a parent state.
+    std::vector<BitsetMath::Word> parent_past_words;
+    std::vector<BitsetMath::Word> parent_fut_words;
+
+    void compute_achieved_words_by_operator();
+    void compute_weak_successors();
+    void compute_fact_indices(const TaskProxy &task_proxy);
+
+    void load_parent_words(const State &parent_ancestor_state);
+    void progress_basic(BitsetView &past, BitsetView &fut, int op_id);
     void progress_goal(const State &ancestor_state, BitsetView &fut);
     void progress_greedy_necessary(const State &ancestor_state,
                                    const BitsetView &past, BitsetView &fut);
+    void progress_triggered(
+        const State &parent_ancestor_state, const State &ancestor_state,
+        int op_id, const BitsetView &past, BitsetView &fut);
+    void progress_goal_and_greedy_necessary(
+        const State &parent_ancestor_state, const State &ancestor_state,
+        int op_id, const BitsetView &past, BitsetView &fut);
+    void progress_uaa(BitsetView &fut, int op_id);
     void progress_weak(const BitsetView &past, BitsetView &fut);
+
+    /*
+      The statuses of *ancestor_state* may only be modified through the
+      views returned by begin_update(), and the changes are only guaranteed
+      to be stored after the matching call to end_update().
+    */
+    std::pair<BitsetView, BitsetView> begin_update(const State &ancestor_state);
+    void end_update(const State &ancestor_state);
 public:
-    explicit DisjunctiveActionLandmarkStatusManager(
-        DisjunctiveActionLandmarkGraph &graph);
+    DisjunctiveActionLandmarkStatusManager(
+        const CompactDisjunctiveActionLandmarkGraph &graph,
+        const TaskProxy &task_proxy, bool intern_statuses);
+    ~DisjunctiveActionLandmarkStatusManager();
 
     BitsetView get_past_landmarks(const State &state);
     BitsetView get_future_landmarks(const State &state);
@@ -37,8 +105,20 @@ public:
     void process_state_transition(
         const State &parent_ancestor_state, OperatorID op_id,
         const State &ancestor_state);
+    /*
+      Process the transitions from *parent_ancestor_state* with each
+      operator in *op_ids* to the corresponding state in *ancestor_states*.
+      This is equivalent to processing them one by one, but the statuses of
+      the parent are only loaded once.
+    */
+    void process_state_transitions(
+        const State &parent_ancestor_state,
+        const std::vector<OperatorID> &op_ids,
+        const std::vector<State> &ancestor_states);
 
     LandmarkStatus get_landmark_status(const State &ancestor_state, size_t id);
+
+    void print_statistics(utils::LogProxy &log) const;
 };
 }
 
@@ -0,0 +1,106 @@
+#include "dalm_status_pool.h"
+
+#include "../utils/hash.h"
+#include "../utils/language.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace landmarks {
+int_hash_set::HashType DisjunctiveActionLandmarkStatusPool::EntryHash::operator()(
+    int handle) const {
+    const Block *data = entries[handle];
+    utils::HashState hash_state;
+    // Feed the blocks in chunks of 32 bits.
+    const int blocks_per_chunk = sizeof(uint32_t) / sizeof(Block);
+    for (int i = 0; i < num_blocks; i += blocks_per_chunk) {
+        uint32_t chunk = 0;
+        int num_chunk_blocks = min(blocks_per_chunk, num_blocks - i);
+        memcpy(&chunk, data + i, num_chunk_blocks * sizeof(Block));
+        hash_state.feed(chunk);
+    }
+    return hash_state.get_hash32();
+}
+
+bool DisjunctiveActionLandmarkStatusPool::EntryEqual::operator()(
+    int lhs, int rhs) const {
+    const Block *lhs_data = entries[lhs];
+    const Block *rhs_data = entries[rhs];
+    return equal(lhs_data, lhs_data + num_blocks, rhs_data);
+}
+
+DisjunctiveActionLandmarkStatusPool::DisjunctiveActionLandmarkStatusPool(
+    const vector<bool> &default_past, const vector<bool> &default_future)
+    : num_past_bits(default_past.size()),
+      num_future_bits(default_future.size()),
+      num_past_blocks(BitsetMath::compute_num_blocks(num_past_bits)),
+      num_blocks(num_past_blocks
+                 + BitsetMath::compute_num_blocks(num_future_bits)),
+      entries(max(num_blocks, 1)),
+      handles(EntryHash(entries, num_blocks), EntryEqual(entries, num_blocks)),
+      scratch(max(num_blocks, 1), 0) {
+    BitsetView past = get_scratch_past();
+    BitsetView future = get_scratch_future();
+    for (int i = 0; i < num_past_bits; ++i) {
+        if (default_past[i]) {
+            past.set(i);
+        }
+    }
+    for (int i = 0; i < num_future_bits; ++i) {
+        if (default_future[i]) {
+            future.set(i);
+        }
+    }
+    int default_handle = intern_scratch();
+    utils::unused_variable(default_handle);
+    assert(default_handle == 0);
+}
+
+BitsetView DisjunctiveActionLandmarkStatusPool::get_past(int handle) {
+    return BitsetView(ArrayView<Block>(entries[handle], num_past_blocks),
+                      num_past_bits);
+}
+
+BitsetView DisjunctiveActionLandmarkStatusPool::get_future(int handle) {
+    return BitsetView(ArrayView<Block>(entries[handle] + num_past_blocks,
+                                       num_blocks - num_past_blocks),
+                      num_future_bits);
+}
+
+void DisjunctiveActionLandmarkStatusPool::load_scratch(int handle) {
+    const Block *data = entries[handle];
+    copy(data, data + num_blocks, scratch.begin());
+}
+
+BitsetView DisjunctiveActionLandmarkStatusPool::get_scratch_past() {
+    return BitsetView(ArrayView<Block>(scratch.data(), num_past_blocks),
+                      num_past_bits);
+}
+
+BitsetView DisjunctiveActionLandmarkStatusPool::get_scratch_future() {
+    return BitsetView(ArrayView<Block>(scratch.data() + num_past_blocks,
+                                       num_blocks - num_past_blocks),
+                      num_future_bits);
+}
+
+int DisjunctiveActionLandmarkStatusPool::intern_scratch() {
+    /*
+      As in the state registry, we append the entry and remove it again if
+      an equal entry is already present.
+    */
+    entries.push_back(scratch.data());
+    pair<int, bool> result = handles.insert(entries.size() - 1);
+    if (!result.second) {
+        entries.pop_back();
+    }
+    assert(handles.size() == static_cast<int>(entries.size()));
+    return result.first;
+}
+
+size_t DisjunctiveActionLandmarkStatusPool::estimate_memory_in_bytes() const {
+    return entries.size() * num_blocks * sizeof(Block)
+           + handles.estimate_memory_in_bytes();
+}
+}
@@ -0,0 +1,92 @@
+#ifndef LANDMARKS_DALM_STATUS_POOL_H
+#define LANDMARKS_DALM_STATUS_POOL_H
+
+#include "../per_state_bitset.h"
+
+#include "../algorithms/int_hash_set.h"
+#include "../algorithms/segmented_vector.h"
+
+#include <vector>
+
+namespace landmarks {
+/*
+  Hash-consed storage for pairs of past and future landmark bitsets. Each
+  distinct pair is stored once and identified by an integer handle, so
+  states that share their landmark status (e.g., states along a plan
+  prefix) only need to store the handle.
+
+  Entries are never modified once they are interned. Handle 0 is the pair
+  of default bitsets passed to the constructor.
+*/
+class DisjunctiveActionLandmarkStatusPool {
+    using Block = BitsetMath::Block;
+
+    struct EntryHash {
+        const segmented_vector::SegmentedArrayVector<Block> &entries;
+        int num_blocks;
+        EntryHash(const segmented_vector::SegmentedArrayVector<Block> &entries,
+                  int num_blocks)
+            : entries(entries), num_blocks(num_blocks) {
+        }
+
+        int_hash_set::HashType operator()(int handle) const;
+    };
+
+    struct EntryEqual {
+        const segmented_vector::SegmentedArrayVector<Block> &entries;
+        int num_blocks;
+        EntryEqual(const segmented_vector::SegmentedArrayVector<Block> &entries,
+                   int num_blocks)
+            : entries(entries), num_blocks(num_blocks) {
+        }
+
+        bool operator()(int lhs, int rhs) const;
+    };
+
+    const int num_past_bits;
+    const int num_future_bits;
+    const int num_past_blocks;
+    const int num_blocks;
+
+    // The blocks of the past bitset of an entry precede those of its future.
+    segmented_vector::SegmentedArrayVector<Block> entries;
+    int_hash_set::IntHashSet<EntryHash, EntryEqual> handles;
+
+    // Buffer for the entry that is currently being computed.
+    std::vector<Block> scratch;
+public:
+    DisjunctiveActionLandmarkStatusPool(
+        const std::vector<bool> &default_past,
+        const std::vector<bool> &default_future);
+
+    DisjunctiveActionLandmarkStatusPool(
+        const DisjunctiveActionLandmarkStatusPool &) = delete;
+    DisjunctiveActionLandmarkStatusPool &operator=(
+        const DisjunctiveActionLandmarkStatusPool &) = delete;
+
+    /*
+      The returned views must only be read. They stay valid for the lifetime
+      of the pool.
+    */
+    BitsetView get_past(int handle);
+    BitsetView get_future(int handle);
+
+    /*
+      Copy the entry of *handle* into the scratch buffer. The scratch entry
+      can be modified freely through its views and is stored with
+      intern_scratch(), which returns the handle of the (possibly already
+      present) entry.
+    */
+    void load_scratch(int handle);
+    BitsetView get_scratch_past();
+    BitsetView get_scratch_future();
+    int intern_scratch();
+
+    int size() const {
+        return handles.size();
+    }
+    std::size_t estimate_memory_in_bytes() const;
+};
+}
+
+#endif
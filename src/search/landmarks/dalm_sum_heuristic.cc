@@ -1,6 +1,6 @@
 #include "dalm_sum_heuristic.h"
 
-#include "dalm_graph.h"
+#include "dalm_compact_graph.h"
 #include "dalm_status_manager.h"
 
 #include "../plugins/plugin.h"
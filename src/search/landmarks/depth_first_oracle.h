@@ -3,6 +3,7 @@
 
 #include "cycle_oracle.h"
 
+#include <cstddef>
 #include <vector>
 
 namespace landmarks {
@@ -60,6 +60,8 @@ Exploration::Exploration(const TaskProxy &task_proxy, utils::LogProxy &log)
         build_unary_operators(op);
     for (OperatorProxy axiom : axioms)
         build_unary_operators(axiom);
+
+    build_flat_layout();
 }
 
 void Exploration::build_unary_operators(const OperatorProxy &op) {
@@ -98,6 +100,72 @@ void Exploration::build_unary_operators(const OperatorProxy &op) {
     }
 }
 
+void Exploration::build_flat_layout() {
+    int num_propositions = 0;
+    for (const vector<Proposition> &props_for_variable : propositions) {
+        proposition_offsets.push_back(num_propositions);
+        num_propositions += props_for_variable.size();
+    }
+
+    /*
+      Unary operators only know their number of preconditions, so we collect
+      the preconditions from the cross-references of the propositions.
+    */
+    int num_unary_ops = unary_operators.size();
+    vector<vector<int>> preconditions(num_unary_ops);
+    vector<vector<int>> precondition_of(num_propositions);
+    for (const vector<Proposition> &props_for_variable : propositions) {
+        for (const Proposition &prop : props_for_variable) {
+            int prop_id = get_proposition_id(prop.fact);
+            for (const UnaryOperator *op : prop.precondition_of) {
+                int op_id = op - unary_operators.data();
+                preconditions[op_id].push_back(prop_id);
+                precondition_of[prop_id].push_back(op_id);
+            }
+        }
+    }
+    flat_precondition_starts.reserve(num_unary_ops + 1);
+    flat_effects.reserve(num_unary_ops);
+    flat_op_or_axiom_ids.reserve(num_unary_ops);
+    for (int op_id = 0; op_id < num_unary_ops; ++op_id) {
+        const UnaryOperator &op = unary_operators[op_id];
+        flat_precondition_starts.push_back(flat_preconditions.size());
+        flat_preconditions.insert(flat_preconditions.end(),
+                                  preconditions[op_id].begin(),
+                                  preconditions[op_id].end());
+        flat_effects.push_back(get_proposition_id(op.effect->fact));
+        flat_op_or_axiom_ids.push_back(op.op_or_axiom_id);
+    }
+    flat_precondition_starts.push_back(flat_preconditions.size());
+
+    flat_precondition_of_starts.reserve(num_propositions + 1);
+    for (const vector<int> &op_ids : precondition_of) {
+        flat_precondition_of_starts.push_back(flat_precondition_of.size());
+        flat_precondition_of.insert(flat_precondition_of.end(),
+                                    op_ids.begin(), op_ids.end());
+    }
+    flat_precondition_of_starts.push_back(flat_precondition_of.size());
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    unconditional_effect_starts.reserve(operators.size() + 1);
+    for (OperatorProxy op : operators) {
+        unconditional_effect_starts.push_back(unconditional_effects.size());
+        for (EffectProxy effect : op.get_effects()) {
+            if (effect.get_conditions().empty()) {
+                unconditional_effects.push_back(
+                    get_proposition_id(effect.get_fact().get_pair()));
+            }
+        }
+    }
+    unconditional_effect_starts.push_back(unconditional_effects.size());
+
+    lanes_reached.resize(num_propositions);
+    lanes_excluded_props.resize(num_propositions);
+    lanes_excluded_ops.resize(operators.size());
+    lanes_applicable.resize(num_unary_ops);
+    in_lane_queue.resize(num_propositions);
+}
+
 /*
   This function initializes the priority queue and the information associated
   with propositions and unary operators for the relaxed exploration. Unary
@@ -226,4 +294,125 @@ vector<vector<bool>> Exploration::compute_relaxed_reachability(
     }
     return reached;
 }
+
+void Exploration::enqueue_lanes_if_necessary(int prop_id, LaneMask lanes) {
+    LaneMask new_lanes = lanes & ~lanes_reached[prop_id];
+    if (new_lanes) {
+        lanes_reached[prop_id] |= new_lanes;
+        if (!in_lane_queue[prop_id]) {
+            in_lane_queue[prop_id] = true;
+            lane_queue.push_back(prop_id);
+        }
+    }
+}
+
+/*
+  The batch exploration computes the same fixpoint as relaxed_exploration
+  in every lane: a unary operator is applicable in the lanes in which it is
+  not excluded and all its preconditions are reached. Whenever a
+  proposition is reached in new lanes, the operators it triggers are
+  re-evaluated on whole lane masks, so the order of processing does not
+  matter.
+*/
+void Exploration::compute_relaxed_reachability_for_lanes(
+    const vector<vector<FactPair>> &excluded_props,
+    const vector<vector<int>> &excluded_op_ids,
+    int first, int num_lanes, vector<vector<vector<bool>>> &result) {
+    assert(num_lanes > 0 && num_lanes <= NUM_LANES);
+    LaneMask all_lanes = (num_lanes == NUM_LANES) ?
+        ~LaneMask(0) : (LaneMask(1) << num_lanes) - 1;
+
+    fill(lanes_reached.begin(), lanes_reached.end(), 0);
+    fill(lanes_excluded_props.begin(), lanes_excluded_props.end(), 0);
+    fill(lanes_excluded_ops.begin(), lanes_excluded_ops.end(), 0);
+    for (int lane = 0; lane < num_lanes; ++lane) {
+        LaneMask lane_bit = LaneMask(1) << lane;
+        for (const FactPair &fact : excluded_props[first + lane]) {
+            lanes_excluded_props[get_proposition_id(fact)] |= lane_bit;
+        }
+        if (!excluded_op_ids.empty()) {
+            for (int op_id : excluded_op_ids[first + lane]) {
+                assert(op_id >= 0);
+                lanes_excluded_ops[op_id] |= lane_bit;
+            }
+        }
+    }
+
+    /*
+      As in setup_exploration_queue, operators that achieve an excluded
+      proposition unconditionally are excluded as a whole.
+    */
+    int num_operators = lanes_excluded_ops.size();
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        for (int i = unconditional_effect_starts[op_id];
+             i < unconditional_effect_starts[op_id + 1]; ++i) {
+            lanes_excluded_ops[op_id] |=
+                lanes_excluded_props[unconditional_effects[i]];
+        }
+    }
+
+    for (FactProxy fact : task_proxy.get_initial_state()) {
+        enqueue_lanes_if_necessary(get_proposition_id(fact.get_pair()), all_lanes);
+    }
+
+    int num_unary_ops = lanes_applicable.size();
+    for (int op_id = 0; op_id < num_unary_ops; ++op_id) {
+        LaneMask excluded = lanes_excluded_props[flat_effects[op_id]];
+        int op_or_axiom_id = flat_op_or_axiom_ids[op_id];
+        if (op_or_axiom_id >= 0) {
+            excluded |= lanes_excluded_ops[op_or_axiom_id];
+        }
+        lanes_applicable[op_id] = all_lanes & ~excluded;
+        if (flat_precondition_starts[op_id] == flat_precondition_starts[op_id + 1]) {
+            enqueue_lanes_if_necessary(flat_effects[op_id], lanes_applicable[op_id]);
+        }
+    }
+
+    while (!lane_queue.empty()) {
+        int prop_id = lane_queue.back();
+        lane_queue.pop_back();
+        in_lane_queue[prop_id] = false;
+        for (int i = flat_precondition_of_starts[prop_id];
+             i < flat_precondition_of_starts[prop_id + 1]; ++i) {
+            int op_id = flat_precondition_of[i];
+            LaneMask lanes = lanes_applicable[op_id];
+            for (int j = flat_precondition_starts[op_id];
+                 lanes && j < flat_precondition_starts[op_id + 1]; ++j) {
+                lanes &= lanes_reached[flat_preconditions[j]];
+            }
+            if (lanes) {
+                enqueue_lanes_if_necessary(flat_effects[op_id], lanes);
+            }
+        }
+    }
+
+    for (int lane = 0; lane < num_lanes; ++lane) {
+        LaneMask lane_bit = LaneMask(1) << lane;
+        vector<vector<bool>> &reached = result[first + lane];
+        reached.resize(propositions.size());
+        for (size_t var_id = 0; var_id < propositions.size(); ++var_id) {
+            int offset = proposition_offsets[var_id];
+            int domain_size = propositions[var_id].size();
+            reached[var_id].resize(domain_size);
+            for (int value = 0; value < domain_size; ++value) {
+                reached[var_id][value] = lanes_reached[offset + value] & lane_bit;
+            }
+        }
+    }
+}
+
+vector<vector<vector<bool>>> Exploration::compute_relaxed_reachability_batch(
+    const vector<vector<FactPair>> &excluded_props,
+    const vector<vector<int>> &excluded_op_ids) {
+    assert(excluded_op_ids.empty()
+           || excluded_op_ids.size() == excluded_props.size());
+    int num_explorations = excluded_props.size();
+    vector<vector<vector<bool>>> result(num_explorations);
+    for (int first = 0; first < num_explorations; first += NUM_LANES) {
+        int num_lanes = min(NUM_LANES, num_explorations - first);
+        compute_relaxed_reachability_for_lanes(
+            excluded_props, excluded_op_ids, first, num_lanes, result);
+    }
+    return result;
+}
 }
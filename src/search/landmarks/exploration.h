@@ -7,6 +7,7 @@
 
 #include "../algorithms/priority_queues.h"
 
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -53,13 +54,61 @@ struct UnaryOperator {
 };
 
 class Exploration {
+public:
+    // Number of explorations compute_relaxed_reachability_batch runs at once.
+    static constexpr int NUM_LANES = 64;
+
+private:
+    /*
+      The batch exploration runs one exploration per bit of a LaneMask, so
+      propositions and unary operators carry a mask of the lanes in which
+      they are reached or excluded.
+    */
+    using LaneMask = std::uint64_t;
+
     TaskProxy task_proxy;
 
     std::vector<UnaryOperator> unary_operators;
     std::vector<std::vector<Proposition>> propositions;
     std::deque<Proposition *> prop_queue;
 
+    /*
+      Flat copy of the unary operators for the batch exploration. Propositions
+      are numbered consecutively, grouped by variable, and the preconditions
+      of unary operator i are the entries flat_preconditions[j] for
+      flat_precondition_starts[i] <= j < flat_precondition_starts[i + 1].
+      The other *_starts vectors index into their vectors in the same way.
+    */
+    std::vector<int> proposition_offsets;
+    std::vector<int> flat_precondition_starts;
+    std::vector<int> flat_preconditions;
+    std::vector<int> flat_effects;
+    std::vector<int> flat_op_or_axiom_ids;
+    std::vector<int> flat_precondition_of_starts;
+    std::vector<int> flat_precondition_of;
+    // Unconditional effects of the operators (not axioms) by operator id.
+    std::vector<int> unconditional_effect_starts;
+    std::vector<int> unconditional_effects;
+
+    // Per-batch scratch space, kept to avoid reallocations.
+    std::vector<LaneMask> lanes_reached;
+    std::vector<LaneMask> lanes_excluded_props;
+    std::vector<LaneMask> lanes_excluded_ops;
+    std::vector<LaneMask> lanes_applicable;
+    std::vector<bool> in_lane_queue;
+    std::vector<int> lane_queue;
+
     void build_unary_operators(const OperatorProxy &op);
+    void build_flat_layout();
+    int get_proposition_id(const FactPair &fact) const {
+        return proposition_offsets[fact.var] + fact.value;
+    }
+    void compute_relaxed_reachability_for_lanes(
+        const std::vector<std::vector<FactPair>> &excluded_props,
+        const std::vector<std::vector<int>> &excluded_op_ids,
+        int first, int num_lanes,
+        std::vector<std::vector<std::vector<bool>>> &result);
+    void enqueue_lanes_if_necessary(int prop_id, LaneMask lanes);
     void setup_exploration_queue(
         const State &state, const std::vector<FactPair> &excluded_props,
         const std::vector<int> &excluded_op_ids);
@@ -80,6 +129,17 @@ public:
     std::vector<std::vector<bool>> compute_relaxed_reachability(
         const std::vector<FactPair> &excluded_props,
         const std::vector<int> &excluded_op_ids);
+
+    /*
+      Computes the same as compute_relaxed_reachability for each pair of
+      excluded_props[i] and excluded_op_ids[i], but runs up to 64 of these
+      explorations at once with one bit per exploration. excluded_op_ids
+      may also be empty if no operators are excluded. Only operator ids
+      (no axiom ids) may be excluded.
+    */
+    std::vector<std::vector<std::vector<bool>>> compute_relaxed_reachability_batch(
+        const std::vector<std::vector<FactPair>> &excluded_props,
+        const std::vector<std::vector<int>> &excluded_op_ids);
 };
 }
 
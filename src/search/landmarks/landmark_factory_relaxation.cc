@@ -5,6 +5,8 @@
 
 #include "../task_utils/task_properties.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace landmarks {
@@ -73,24 +75,34 @@ void LandmarkFactoryRelaxation::calc_achievers(
     const TaskProxy &task_proxy, Exploration &exploration) {
     assert(!achievers_calculated);
     VariablesProxy variables = task_proxy.get_variables();
-    for (auto &lm_node : lm_graph->get_nodes()) {
-        Landmark &landmark = lm_node->get_landmark();
-        for (const FactPair &lm_fact : landmark.facts) {
-            const vector<int> &ops = get_operators_including_eff(lm_fact);
-            landmark.possible_achievers.insert(ops.begin(), ops.end());
-
-            if (variables[lm_fact.var].is_derived())
-                landmark.is_derived = true;
+    const LandmarkGraph::Nodes &nodes = lm_graph->get_nodes();
+    int num_landmarks = nodes.size();
+    // Explore for up to Exploration::NUM_LANES landmarks at once.
+    for (int begin = 0; begin < num_landmarks; begin += Exploration::NUM_LANES) {
+        int end = min(begin + Exploration::NUM_LANES, num_landmarks);
+        vector<vector<FactPair>> excluded_props;
+        for (int i = begin; i < end; ++i) {
+            excluded_props.push_back(nodes[i]->get_landmark().facts);
         }
+        vector<vector<vector<bool>>> reached =
+            exploration.compute_relaxed_reachability_batch(excluded_props, {});
+
+        for (int i = begin; i < end; ++i) {
+            Landmark &landmark = nodes[i]->get_landmark();
+            for (const FactPair &lm_fact : landmark.facts) {
+                const vector<int> &ops = get_operators_including_eff(lm_fact);
+                landmark.possible_achievers.insert(ops.begin(), ops.end());
 
-        vector<vector<bool>> reached =
-            compute_relaxed_reachability(exploration, landmark);
+                if (variables[lm_fact.var].is_derived())
+                    landmark.is_derived = true;
+            }
 
-        for (int op_or_axom_id : landmark.possible_achievers) {
-            OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
+            for (int op_or_axom_id : landmark.possible_achievers) {
+                OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
 
-            if (possibly_reaches_lm(op, reached, landmark)) {
-                landmark.first_achievers.insert(op_or_axom_id);
+                if (possibly_reaches_lm(op, reached[i - begin], landmark)) {
+                    landmark.first_achievers.insert(op_or_axom_id);
+                }
             }
         }
     }
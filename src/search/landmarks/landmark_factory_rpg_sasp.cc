@@ -1,5 +1,6 @@
 #include "landmark_factory_rpg_sasp.h"
 
+#include "exploration.h"
 #include "landmark.h"
 #include "landmark_graph.h"
 #include "util.h"
@@ -8,6 +9,8 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -21,7 +24,8 @@ LandmarkFactoryRpgSasp::LandmarkFactoryRpgSasp(const plugins::Options &opts)
     : LandmarkFactoryRelaxation(opts),
       disjunctive_landmarks(opts.get<bool>("disjunctive_landmarks")),
       use_orders(opts.get<bool>("use_orders")),
-      only_causal_landmarks(opts.get<bool>("only_causal_landmarks")) {
+      only_causal_landmarks(opts.get<bool>("only_causal_landmarks")),
+      num_threads(opts.get<int>("num_threads")) {
 }
 
 void LandmarkFactoryRpgSasp::build_dtg_successors(const TaskProxy &task_proxy) {
@@ -170,6 +174,7 @@ void LandmarkFactoryRpgSasp::found_simple_lm_and_order(
             open_landmarks.erase(it);
         }
         forward_orders.erase(disj_lm);
+        prefetched_backchaining.erase(disj_lm);
 
         // Retrieve incoming edges from disj_lm
         vector<LandmarkNode *> predecessors;
@@ -238,7 +243,7 @@ void LandmarkFactoryRpgSasp::found_disj_lm_and_order(
 
 void LandmarkFactoryRpgSasp::compute_shared_preconditions(
     const TaskProxy &task_proxy, unordered_map<int, int> &shared_pre,
-    vector<vector<bool>> &reached, const Landmark &landmark) {
+    const vector<vector<bool>> &reached, const Landmark &landmark) const {
     /*
       Compute the shared preconditions of all operators that can potentially
       achieve landmark bp, given the reachability in the relaxed planning graph.
@@ -334,7 +339,7 @@ void LandmarkFactoryRpgSasp::build_disjunction_classes(const TaskProxy &task_pro
 
 void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
     const TaskProxy &task_proxy, vector<set<FactPair>> &disjunctive_pre,
-    vector<vector<bool>> &reached, const Landmark &landmark) {
+    const vector<vector<bool>> &reached, const Landmark &landmark) {
     /*
       Compute disjunctive preconditions from all operators than can potentially
       achieve landmark bp, given the reachability in the relaxed planning graph.
@@ -389,6 +394,68 @@ void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
     }
 }
 
+void LandmarkFactoryRpgSasp::compute_backchaining_info(
+    const TaskProxy &task_proxy, const Landmark &landmark,
+    BackchainingInfo &info) const {
+    /*
+      Use the propositions that can be reached without achieving the
+      landmark to determine all operators that can possibly achieve
+      *landmark* for the first time, and collect any precondition
+      propositions that all such operators share (if there are any).
+    */
+    compute_shared_preconditions(task_proxy, info.shared_pre,
+                                 info.reached, landmark);
+}
+
+void LandmarkFactoryRpgSasp::prefetch_backchaining_infos(
+    const TaskProxy &task_proxy, const State &initial_state,
+    const vector<Exploration *> &explorations) {
+    vector<const LandmarkNode *> lm_nodes;
+    for (const LandmarkNode *lm_node : open_landmarks) {
+        if (!lm_node->get_landmark().is_true_in_state(initial_state) &&
+            !prefetched_backchaining.count(lm_node)) {
+            lm_nodes.push_back(lm_node);
+        }
+    }
+
+    int num_landmarks = lm_nodes.size();
+    if (num_landmarks == 0) {
+        return;
+    }
+
+    /*
+      Each chunk of landmarks is explored in one batch exploration. Chunks
+      are made smaller than a full batch if that gives every thread work.
+    */
+    int num_workers = explorations.size();
+    int chunk_size = min(Exploration::NUM_LANES,
+                         (num_landmarks + num_workers - 1) / num_workers);
+    int num_chunks = (num_landmarks + chunk_size - 1) / chunk_size;
+    vector<BackchainingInfo> infos(num_landmarks);
+    utils::parallel_for(
+        num_chunks, num_workers,
+        [&](int worker_id, int chunk) {
+            int begin = chunk * chunk_size;
+            int end = min(begin + chunk_size, num_landmarks);
+            vector<vector<FactPair>> excluded_props;
+            for (int i = begin; i < end; ++i) {
+                excluded_props.push_back(lm_nodes[i]->get_landmark().facts);
+            }
+            vector<vector<vector<bool>>> reached =
+                explorations[worker_id]->compute_relaxed_reachability_batch(
+                    excluded_props, {});
+            for (int i = begin; i < end; ++i) {
+                infos[i].reached = move(reached[i - begin]);
+                compute_backchaining_info(
+                    task_proxy, lm_nodes[i]->get_landmark(), infos[i]);
+            }
+        });
+
+    for (int i = 0; i < num_landmarks; ++i) {
+        prefetched_backchaining.emplace(lm_nodes[i], move(infos[i]));
+    }
+}
+
 void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
     const shared_ptr<AbstractTask> &task, Exploration &exploration) {
     TaskProxy task_proxy(*task);
@@ -404,10 +471,34 @@ void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
         open_landmarks.push_back(&lm_node);
     }
 
+    /*
+      The calling exploration serves the first thread, the other threads
+      get their own because explorations keep their state internally.
+    */
+    vector<unique_ptr<Exploration>> additional_explorations;
+    vector<Exploration *> explorations = {&exploration};
+    utils::LogProxy silent_log = utils::get_silent_log();
+    for (int i = 1; i < num_threads; ++i) {
+        additional_explorations.push_back(
+            utils::make_unique_ptr<Exploration>(task_proxy, silent_log));
+        explorations.push_back(additional_explorations.back().get());
+    }
+
     State initial_state = task_proxy.get_initial_state();
     while (!open_landmarks.empty()) {
         LandmarkNode *lm_node = open_landmarks.front();
         Landmark &landmark = lm_node->get_landmark();
+        if (!landmark.is_true_in_state(initial_state) &&
+            !prefetched_backchaining.count(lm_node)) {
+            /*
+              The infos only depend on the landmark, and landmarks are
+              processed in the order of open_landmarks either way, so
+              computing them in advance does not change the graph. Infos
+              of disjunctive landmarks replaced in the meantime are
+              discarded in found_simple_lm_and_order.
+            */
+            prefetch_backchaining_infos(task_proxy, initial_state, explorations);
+        }
         open_landmarks.pop_front();
         assert(forward_orders[lm_node].empty());
 
@@ -415,25 +506,17 @@ void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
             /*
               Backchain from *landmark* and compute greedy necessary
               predecessors.
-              Firstly, collect which propositions can be reached without
-              achieving the landmark.
-            */
-            vector<vector<bool>> reached =
-                compute_relaxed_reachability(exploration, landmark);
-            /*
-              Use this information to determine all operators that can
-              possibly achieve *landmark* for the first time, and collect
-              any precondition propositions that all such operators share
-              (if there are any).
             */
-            unordered_map<int, int> shared_pre;
-            compute_shared_preconditions(task_proxy, shared_pre,
-                                         reached, landmark);
+            auto it = prefetched_backchaining.find(lm_node);
+            assert(it != prefetched_backchaining.end());
+            BackchainingInfo info = move(it->second);
+            prefetched_backchaining.erase(it);
+            const vector<vector<bool>> &reached = info.reached;
             /*
-              All such shared preconditions are landmarks, and greedy
-              necessary predecessors of *landmark*.
+              All shared preconditions of the first achievers are landmarks,
+              and greedy necessary predecessors of *landmark*.
             */
-            for (const auto &pre : shared_pre) {
+            for (const auto &pre : info.shared_pre) {
                 found_simple_lm_and_order(
                     FactPair(pre.first, pre.second), *lm_node,
                     EdgeType::GREEDY_NECESSARY);
@@ -650,6 +733,13 @@ public:
         add_landmark_factory_options_to_feature(*this);
         add_use_orders_option_to_feature(*this);
         add_only_causal_landmarks_option_to_feature(*this);
+        add_option<int>(
+            "num_threads",
+            "number of threads running the relaxed explorations of open "
+            "landmarks concurrently. The resulting landmark graph is the same "
+            "for every number of threads.",
+            "1",
+            plugins::Bounds("1", "infinity"));
 
         document_language_support(
             "conditional_effects",
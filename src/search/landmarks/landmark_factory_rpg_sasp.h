@@ -3,6 +3,7 @@
 
 #include "landmark_factory_relaxation.h"
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -12,7 +13,20 @@ class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
     const bool disjunctive_landmarks;
     const bool use_orders;
     const bool only_causal_landmarks;
+    const int num_threads;
+
+    /*
+      What the back-chaining step derives for a landmark from a relaxed
+      exploration that excludes it, independently of the landmark graph.
+      It is computed in batches for the open landmarks.
+    */
+    struct BackchainingInfo {
+        std::vector<std::vector<bool>> reached;
+        std::unordered_map<int, int> shared_pre;
+    };
+
     std::list<LandmarkNode *> open_landmarks;
+    std::unordered_map<const LandmarkNode *, BackchainingInfo> prefetched_backchaining;
     std::vector<std::vector<int>> disjunction_classes;
 
     std::unordered_map<LandmarkNode *, utils::HashSet<FactPair>> forward_orders;
@@ -35,12 +49,25 @@ class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
     void compute_shared_preconditions(
         const TaskProxy &task_proxy,
         std::unordered_map<int, int> &shared_pre,
-        std::vector<std::vector<bool>> &reached, const Landmark &landmark);
+        const std::vector<std::vector<bool>> &reached,
+        const Landmark &landmark) const;
     void compute_disjunctive_preconditions(
         const TaskProxy &task_proxy,
         std::vector<std::set<FactPair>> &disjunctive_pre,
-        std::vector<std::vector<bool>> &reached,
+        const std::vector<std::vector<bool>> &reached,
         const Landmark &landmark);
+    // Complete *info* given the reachability in info.reached.
+    void compute_backchaining_info(
+        const TaskProxy &task_proxy, const Landmark &landmark,
+        BackchainingInfo &info) const;
+    /*
+      Compute the back-chaining information of all open landmarks that are
+      not true initially with batch explorations on num_threads threads,
+      one exploration per thread.
+    */
+    void prefetch_backchaining_infos(
+        const TaskProxy &task_proxy, const State &initial_state,
+        const std::vector<Exploration *> &explorations);
 
     virtual void generate_relaxed_landmarks(
         const std::shared_ptr<AbstractTask> &task,
@@ -146,7 +146,9 @@ LPSolver::LPSolver(LPSolverType solver_type)
       is_mip(false),
       is_solved(false),
       num_permanent_constraints(0),
-      has_temporary_constraints_(false) {
+      has_temporary_constraints_(false),
+      num_solves(0),
+      num_simplex_iterations(0) {
     try {
         lp_solver = create_lp_solver(solver_type);
     } catch (CoinError &error) {
@@ -267,32 +269,44 @@ void LPSolver::load_problem(const LinearProgram &lp) {
     clear_temporary_data();
 }
 
+void LPSolver::add_rows(const vector<LPConstraint> &constraints) {
+    clear_temporary_data();
+    int num_rows = constraints.size();
+    for (const LPConstraint &constraint : constraints) {
+        row_lb.push_back(constraint.get_lower_bound());
+        row_ub.push_back(constraint.get_upper_bound());
+        rows.push_back(new CoinShallowPackedVector(
+                           constraint.get_variables().size(),
+                           constraint.get_variables().data(),
+                           constraint.get_coefficients().data(),
+                           false));
+    }
+
+    try {
+        lp_solver->addRows(num_rows,
+                           rows.data(), row_lb.data(), row_ub.data());
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
+    for (CoinPackedVectorBase *row : rows) {
+        delete row;
+    }
+    clear_temporary_data();
+    is_solved = false;
+}
+
 void LPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints) {
     if (!constraints.empty()) {
-        clear_temporary_data();
-        int num_rows = constraints.size();
-        for (const LPConstraint &constraint : constraints) {
-            row_lb.push_back(constraint.get_lower_bound());
-            row_ub.push_back(constraint.get_upper_bound());
-            rows.push_back(new CoinShallowPackedVector(
-                               constraint.get_variables().size(),
-                               constraint.get_variables().data(),
-                               constraint.get_coefficients().data(),
-                               false));
-        }
-
-        try {
-            lp_solver->addRows(num_rows,
-                               rows.data(), row_lb.data(), row_ub.data());
-        } catch (CoinError &error) {
-            handle_coin_error(error);
-        }
-        for (CoinPackedVectorBase *row : rows) {
-            delete row;
-        }
-        clear_temporary_data();
+        add_rows(constraints);
         has_temporary_constraints_ = true;
-        is_solved = false;
+    }
+}
+
+void LPSolver::add_permanent_constraints(const vector<LPConstraint> &constraints) {
+    assert(!has_temporary_constraints_);
+    if (!constraints.empty()) {
+        add_rows(constraints);
+        num_permanent_constraints += constraints.size();
     }
 }
 
@@ -395,6 +409,8 @@ void LPSolver::solve() {
         if (is_mip) {
             lp_solver->branchAndBound();
         }
+        ++num_solves;
+        num_simplex_iterations += lp_solver->getIterationCount();
         if (lp_solver->isAbandoned()) {
             // The documentation of OSI is not very clear here but memory seems
             // to be the most common cause for this in our case.
@@ -497,6 +513,14 @@ int LPSolver::has_temporary_constraints() const {
     return has_temporary_constraints_;
 }
 
+int LPSolver::get_num_solves() const {
+    return num_solves;
+}
+
+size_t LPSolver::get_num_simplex_iterations() const {
+    return num_simplex_iterations;
+}
+
 void LPSolver::print_statistics() const {
     utils::g_log << "LP variables: " << get_num_variables() << endl;
     utils::g_log << "LP constraints: " << get_num_constraints() << endl;
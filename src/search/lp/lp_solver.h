@@ -122,6 +122,8 @@ class LPSolver {
     bool is_solved;
     int num_permanent_constraints;
     bool has_temporary_constraints_;
+    int num_solves;
+    size_t num_simplex_iterations;
 #ifdef USE_LP
     std::unique_ptr<OsiSolverInterface> lp_solver;
 #endif
@@ -140,6 +142,7 @@ class LPSolver {
     std::vector<double> row_ub;
     std::vector<CoinPackedVectorBase *> rows;
     void clear_temporary_data();
+    void add_rows(const std::vector<LPConstraint> &constraints);
 public:
     LP_METHOD(explicit LPSolver(LPSolverType solver_type))
     /*
@@ -152,6 +155,11 @@ public:
 
     LP_METHOD(void load_problem(const LinearProgram &lp))
     LP_METHOD(void add_temporary_constraints(const std::vector<LPConstraint> &constraints))
+    /*
+      Add constraints that are kept by clear_temporary_constraints. This is
+      only possible while there are no temporary constraints.
+    */
+    LP_METHOD(void add_permanent_constraints(const std::vector<LPConstraint> &constraints))
     LP_METHOD(void clear_temporary_constraints())
     LP_METHOD(double get_infinity() const)
 
@@ -197,6 +205,9 @@ public:
     LP_METHOD(int get_num_variables() const)
     LP_METHOD(int get_num_constraints() const)
     LP_METHOD(int has_temporary_constraints() const)
+    // Number of calls to solve() and simplex iterations over all of them.
+    LP_METHOD(int get_num_solves() const)
+    LP_METHOD(size_t get_num_simplex_iterations() const)
     LP_METHOD(void print_statistics() const)
 };
 #ifdef __GNUG__
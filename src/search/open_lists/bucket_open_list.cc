@@ -0,0 +1,463 @@
+#include "bucket_open_list.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include "../plugins/plugin.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+/*
+  FIFO queue stored in a vector. Removed entries are only dropped from the
+  front once they make up half of the vector, and large vectors are
+  released when the bucket runs empty, so that the buckets of f-layers that
+  A* has finished do not keep their memory.
+*/
+template<class Entry>
+class FifoBucket {
+    static const size_t MAX_RETAINED_CAPACITY = 1024;
+
+    vector<Entry> entries;
+    size_t front;
+public:
+    FifoBucket()
+        : front(0) {
+    }
+
+    bool empty() const {
+        return front == entries.size();
+    }
+
+    void push_back(const Entry &entry) {
+        entries.push_back(entry);
+    }
+
+    Entry pop_front() {
+        assert(!empty());
+        Entry result = entries[front++];
+        if (front == entries.size()) {
+            if (entries.capacity() > MAX_RETAINED_CAPACITY) {
+                vector<Entry>().swap(entries);
+            } else {
+                entries.clear();
+            }
+            front = 0;
+        } else if (front >= MAX_RETAINED_CAPACITY && 2 * front >= entries.size()) {
+            entries.erase(entries.begin(), entries.begin() + front);
+            front = 0;
+        }
+        return result;
+    }
+};
+
+/*
+  Buckets indexed by int keys. Keys in [0, MAX_DENSE_KEY] index an array
+  that grows on demand. All other keys (negative values, large action
+  costs, infinite tie-breaking values) are kept in an ordered map whose
+  buckets are removed when they run empty.
+
+  The array remembers a lower bound on its smallest non-empty key. The key
+  of the next bucket is usually close to that of the last one (and never
+  smaller for f-values in A* with a consistent heuristic), so finding it
+  by a linear scan is cheap when amortized over all removals.
+
+  Users must add exactly one entry to the bucket returned by
+  get_bucket_for_insertion and call remove_entry after taking one entry
+  from the bucket returned by get_min_bucket.
+*/
+template<class Bucket>
+class BucketArray {
+    static const int MAX_DENSE_KEY = (1 << 20) - 1;
+
+    vector<Bucket> dense_buckets;
+    // All dense buckets with smaller keys are empty.
+    int min_dense_key;
+    int num_dense_entries;
+    map<int, Bucket> sparse_buckets;
+
+    static bool is_dense_key(int key) {
+        return key >= 0 && key <= MAX_DENSE_KEY;
+    }
+
+public:
+    BucketArray()
+        : min_dense_key(0), num_dense_entries(0) {
+    }
+
+    Bucket &get_bucket_for_insertion(int key) {
+        if (is_dense_key(key)) {
+            if (key >= static_cast<int>(dense_buckets.size())) {
+                dense_buckets.resize(
+                    max<size_t>(key + 1, 2 * dense_buckets.size()));
+            }
+            ++num_dense_entries;
+            min_dense_key = min(min_dense_key, key);
+            return dense_buckets[key];
+        }
+        return sparse_buckets[key];
+    }
+
+    Bucket &get_min_bucket(int &key) {
+        assert(!empty());
+        if (!sparse_buckets.empty() &&
+            (num_dense_entries == 0 || sparse_buckets.begin()->first < 0)) {
+            auto it = sparse_buckets.begin();
+            key = it->first;
+            return it->second;
+        }
+        while (dense_buckets[min_dense_key].empty()) {
+            ++min_dense_key;
+        }
+        key = min_dense_key;
+        return dense_buckets[min_dense_key];
+    }
+
+    void remove_entry(int key) {
+        if (is_dense_key(key)) {
+            --num_dense_entries;
+        } else {
+            auto it = sparse_buckets.find(key);
+            assert(it != sparse_buckets.end());
+            if (it->second.empty()) {
+                sparse_buckets.erase(it);
+            }
+        }
+    }
+
+    bool empty() const {
+        return num_dense_entries == 0 && sparse_buckets.empty();
+    }
+
+    void clear() {
+        dense_buckets.clear();
+        min_dense_key = 0;
+        num_dense_entries = 0;
+        sparse_buckets.clear();
+    }
+};
+
+
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    BucketArray<FifoBucket<Entry>> buckets;
+
+    shared_ptr<Evaluator> evaluator;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketOpenList(const plugins::Options &opts);
+    virtual ~BucketOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(const plugins::Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      evaluator(opts.get<shared_ptr<Evaluator>>("eval")) {
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int key = eval_context.get_evaluator_value(evaluator.get());
+    buckets.get_bucket_for_insertion(key).push_back(entry);
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min() {
+    int key;
+    Entry result = buckets.get_min_bucket(key).pop_front();
+    buckets.remove_entry(key);
+    return result;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return buckets.empty();
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    buckets.clear();
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    return eval_context.is_evaluator_value_infinite(evaluator.get());
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    return is_dead_end(eval_context) && evaluator->dead_ends_are_reliable();
+}
+
+
+static const int MAX_TIEBREAKING_EVALUATORS = 4;
+// Values of all evaluators but the first, padded with zeros.
+using SecondaryKey = array<int, MAX_TIEBREAKING_EVALUATORS - 1>;
+
+template<class Entry>
+class TieBreakingBucketOpenList : public OpenList<Entry> {
+    using SecondaryBuckets = map<SecondaryKey, FifoBucket<Entry>>;
+
+    BucketArray<SecondaryBuckets> buckets;
+
+    /*
+      Lazy search inserts all successor edges of an expansion with the
+      values of the expanded state, so edge lists remember the last bucket
+      and skip the secondary lookup for runs of equal keys. The cached
+      bucket lives in a map node, which stays in place when the array of
+      primary buckets grows, as long as maps are moved and not copied.
+    */
+    static const bool cache_last_bucket = is_same<Entry, EdgeOpenListEntry>::value;
+    static_assert(is_nothrow_move_constructible<SecondaryBuckets>::value,
+                  "Growing the bucket array must not copy the maps.");
+    int last_primary_key;
+    SecondaryKey last_secondary_key;
+    FifoBucket<Entry> *last_bucket;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit TieBreakingBucketOpenList(const plugins::Options &opts);
+    virtual ~TieBreakingBucketOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+TieBreakingBucketOpenList<Entry>::TieBreakingBucketOpenList(
+    const plugins::Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      last_primary_key(0),
+      last_secondary_key(),
+      last_bucket(nullptr),
+      evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")),
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
+    assert(!evaluators.empty());
+    assert(static_cast<int>(evaluators.size()) <= MAX_TIEBREAKING_EVALUATORS);
+}
+
+template<class Entry>
+void TieBreakingBucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int primary_key = eval_context.get_evaluator_value_or_infinity(
+        evaluators[0].get());
+    SecondaryKey secondary_key {};
+    for (size_t i = 1; i < evaluators.size(); ++i) {
+        secondary_key[i - 1] = eval_context.get_evaluator_value_or_infinity(
+            evaluators[i].get());
+    }
+
+    SecondaryBuckets &secondary_buckets =
+        buckets.get_bucket_for_insertion(primary_key);
+    if (!cache_last_bucket || !last_bucket ||
+        primary_key != last_primary_key ||
+        secondary_key != last_secondary_key) {
+        last_primary_key = primary_key;
+        last_secondary_key = secondary_key;
+        last_bucket = &secondary_buckets[secondary_key];
+    }
+    last_bucket->push_back(entry);
+}
+
+template<class Entry>
+Entry TieBreakingBucketOpenList<Entry>::remove_min() {
+    int primary_key;
+    SecondaryBuckets &secondary_buckets = buckets.get_min_bucket(primary_key);
+    assert(!secondary_buckets.empty());
+    auto it = secondary_buckets.begin();
+    Entry result = it->second.pop_front();
+    if (it->second.empty()) {
+        if (&it->second == last_bucket)
+            last_bucket = nullptr;
+        secondary_buckets.erase(it);
+    }
+    buckets.remove_entry(primary_key);
+    return result;
+}
+
+template<class Entry>
+bool TieBreakingBucketOpenList<Entry>::empty() const {
+    return buckets.empty();
+}
+
+template<class Entry>
+void TieBreakingBucketOpenList<Entry>::clear() {
+    buckets.clear();
+    last_bucket = nullptr;
+}
+
+template<class Entry>
+void TieBreakingBucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+bool TieBreakingBucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // Same semantics as the "tiebreaking" open list.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template<class Entry>
+bool TieBreakingBucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+
+BucketOpenListFactory::BucketOpenListFactory(
+    const plugins::Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+TieBreakingBucketOpenListFactory::TieBreakingBucketOpenListFactory(
+    const plugins::Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+TieBreakingBucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<TieBreakingBucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+TieBreakingBucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<TieBreakingBucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+class BucketOpenListFeature : public plugins::TypedFeature<OpenListFactory, BucketOpenListFactory> {
+public:
+    BucketOpenListFeature() : TypedFeature("bucket") {
+        document_title("Bucket open list");
+        document_synopsis(
+            "Open list that uses a single evaluator and FIFO tiebreaking. "
+            "It behaves like the \"single\" open list, but stores its "
+            "buckets in an array indexed by the evaluator value.");
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator");
+        add_option<bool>(
+            "pref_only",
+            "insert only nodes generated by preferred operators", "false");
+
+        document_note(
+            "Implementation Notes",
+            "Evaluator values between 0 and 2^20 - 1 index an array of "
+            "buckets that grows on demand. Other values are stored in a "
+            "map from evaluator values to buckets. Inserting an entry with "
+            "an array key takes constant time. Removing the minimum takes "
+            "amortized constant time if the minimum key increases "
+            "monotonically, as in A* with a consistent heuristic, and "
+            "otherwise time linear in the decrease of the minimum key.");
+    }
+};
+
+static plugins::FeaturePlugin<BucketOpenListFeature> _plugin_bucket;
+
+class TieBreakingBucketOpenListFeature : public plugins::TypedFeature<OpenListFactory, TieBreakingBucketOpenListFactory> {
+public:
+    TieBreakingBucketOpenListFeature() : TypedFeature("tiebreaking_bucket") {
+        document_title("Tie-breaking bucket open list");
+        document_synopsis(
+            "Behaves like the \"tiebreaking\" open list, but stores its "
+            "buckets in an array indexed by the value of the first evaluator "
+            "and orders the entries of each bucket by fixed-size keys "
+            "holding the values of the other evaluators.");
+
+        add_list_option<shared_ptr<Evaluator>>(
+            "evals", "evaluators (at most 4)");
+        add_option<bool>(
+            "pref_only",
+            "insert only nodes generated by preferred operators", "false");
+        add_option<bool>(
+            "unsafe_pruning",
+            "allow unsafe pruning when the main evaluator regards a state a dead end",
+            "true");
+    }
+
+    virtual shared_ptr<TieBreakingBucketOpenListFactory> create_component(const plugins::Options &options, const utils::Context &context) const override {
+        plugins::verify_list_non_empty<shared_ptr<Evaluator>>(context, options, "evals");
+        if (static_cast<int>(options.get_list<shared_ptr<Evaluator>>("evals").size()) >
+            MAX_TIEBREAKING_EVALUATORS) {
+            context.error("List argument 'evals' may contain at most " +
+                          to_string(MAX_TIEBREAKING_EVALUATORS) + " evaluators.");
+        }
+        return make_shared<TieBreakingBucketOpenListFactory>(options);
+    }
+};
+
+static plugins::FeaturePlugin<TieBreakingBucketOpenListFeature> _plugin_tiebreaking_bucket;
+}
@@ -0,0 +1,42 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+
+#include "../plugins/options.h"
+
+/*
+  Open lists indexed by ints that store their buckets in an array indexed
+  by the (primary) evaluator value instead of a map. Keys that are negative
+  or too large for the array go to an ordered map.
+
+  The tie-breaking variant orders the entries of each array bucket by the
+  values of the remaining evaluators, stored as fixed-size keys.
+
+  Both use FIFO tie-breaking for equal keys, so they return entries in the
+  same order as the map-based "single" and "tiebreaking" open lists.
+*/
+
+namespace bucket_open_list {
+class BucketOpenListFactory : public OpenListFactory {
+    plugins::Options options;
+public:
+    explicit BucketOpenListFactory(const plugins::Options &options);
+    virtual ~BucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+
+class TieBreakingBucketOpenListFactory : public OpenListFactory {
+    plugins::Options options;
+public:
+    explicit TieBreakingBucketOpenListFactory(const plugins::Options &options);
+    virtual ~TieBreakingBucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
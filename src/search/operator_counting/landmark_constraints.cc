@@ -3,11 +3,14 @@
 
 #include "../algorithms/johnson_cycle_detection.h"
 #include "../landmarks/cycle_oracle.h"
+#include "../landmarks/cycle_pool.h"
 #include "../landmarks/depth_first_oracle.h"
 #include "../landmarks/floyd_warshall_oracle.h"
-#include "../landmarks/dalm_graph.h"
+#include "../landmarks/dalm_compact_graph.h"
 #include "../landmarks/dalm_status_manager.h"
 #include "../plugins/plugin.h"
+#include "../utils/logging.h"
+#include "../utils/memory.h"
 
 using namespace landmarks;
 using namespace std;
@@ -17,13 +20,16 @@ using TypedAdjacencyList = std::vector<std::unordered_map<int, bool>>;
 
 namespace operator_counting {
 static AdjacencyList compute_adj_list(
-    const shared_ptr<DisjunctiveActionLandmarkGraph> &lm_graph) {
+    const shared_ptr<CompactDisjunctiveActionLandmarkGraph> &lm_graph) {
     int num_lms = static_cast<int>(lm_graph->get_number_of_landmarks());
     AdjacencyList adj(num_lms, vector<int>{});
     for (int id = 0; id < num_lms; ++id) {
-        for (auto &parent : lm_graph->get_dependencies(id)) {
-            if (!lm_graph->is_true_in_initial(parent.first)) {
-                adj[parent.first].push_back(id);
+        for (span<const int> parents : {lm_graph->get_strong_parents(id),
+                                        lm_graph->get_weak_parents(id)}) {
+            for (int parent : parents) {
+                if (!lm_graph->is_true_in_initial(parent)) {
+                    adj[parent].push_back(id);
+                }
             }
         }
     }
@@ -32,15 +38,21 @@ static AdjacencyList compute_adj_list(
 
 static TypedAdjacencyList compute_typed_adj_list(
     const State &ancestor_state,
-    const shared_ptr<DisjunctiveActionLandmarkGraph> &lm_graph,
+    const shared_ptr<CompactDisjunctiveActionLandmarkGraph> &lm_graph,
     const shared_ptr<DisjunctiveActionLandmarkStatusManager> &lm_status_manager) {
     int num_lms = static_cast<int>(lm_graph->get_number_of_landmarks());
     TypedAdjacencyList adj(num_lms, unordered_map<int, bool>{});
     for (int id = 0; id < num_lms; ++id) {
-        for (auto &parent : lm_graph->get_dependencies(id)) {
+        for (int parent : lm_graph->get_strong_parents(id)) {
             if (lm_status_manager->get_landmark_status(
-                ancestor_state, parent.first) == FUTURE) {
-                adj[parent.first][id] = parent.second == OrderingType::WEAK;
+                ancestor_state, parent) == FUTURE) {
+                adj[parent][id] = false;
+            }
+        }
+        for (int parent : lm_graph->get_weak_parents(id)) {
+            if (lm_status_manager->get_landmark_status(
+                ancestor_state, parent) == FUTURE) {
+                adj[parent][id] = true;
             }
         }
     }
@@ -48,7 +60,7 @@ static TypedAdjacencyList compute_typed_adj_list(
 }
 
 static vector<float> compute_landmark_weights(
-    const shared_ptr<DisjunctiveActionLandmarkGraph> &lm_graph,
+    const shared_ptr<CompactDisjunctiveActionLandmarkGraph> &lm_graph,
     const vector<double> &counts) {
     size_t n = lm_graph->get_number_of_landmarks();
     vector<float> weights(n, 0);
@@ -63,12 +75,22 @@ static vector<float> compute_landmark_weights(
 
 LandmarkConstraints::LandmarkConstraints(
     const plugins::Options &opts,
-    const shared_ptr<DisjunctiveActionLandmarkGraph> &lm_graph,
+    const shared_ptr<CompactDisjunctiveActionLandmarkGraph> &lm_graph,
     const shared_ptr<DisjunctiveActionLandmarkStatusManager> &lm_status_manager)
     : cycle_generator(opts.get<CycleGenerator>("cycle_generator")),
       strong(opts.get<bool>("strong")),
+      incremental(opts.get<bool>("incremental")),
       lm_graph(lm_graph),
       lm_status_manager(lm_status_manager) {
+    int cycle_pool_size = opts.get<int>("cycle_pool_size");
+    if (cycle_pool_size > 0 && !incremental &&
+        (cycle_generator == CycleGenerator::FLOYD_WARSHALL ||
+         cycle_generator == CycleGenerator::DEPTH_FIRST)) {
+        cycle_pool = utils::make_unique_ptr<CyclePool>(cycle_pool_size);
+    }
+}
+
+LandmarkConstraints::~LandmarkConstraints() {
 }
 
 void LandmarkConstraints::add_landmark_constraints(
@@ -185,42 +207,78 @@ bool LandmarkConstraints::update_landmark_constraints(
 bool LandmarkConstraints::update_cycle_constraints(
     const State &ancestor_state, lp::LPSolver &lp_solver) {
     assert(cycle_generator != CycleGenerator::NONE);
-    int num_landmarks = static_cast<int>(lm_graph->get_number_of_landmarks());
-    int num_cycles = static_cast<int>(cycles.size());
     if (cycle_generator == CycleGenerator::JOHNSON) {
         assert(!cycles.empty());
-        for (int i = 0; i < num_cycles; ++i) {
-            bool cycle_active = all_of(
-                cycles[i].begin(), cycles[i].end(), [&](int id) {
-                    return lm_status_manager->get_landmark_status(
-                        ancestor_state, id) == landmarks::FUTURE;
-                });
-            double lower_bound = cycle_active ? cycles[i].size() + 1.0 : 0.0;
-            lp_solver.set_constraint_lower_bound(
-                num_landmarks + i, lower_bound);
-        }
+        activate_cycle_constraints(ancestor_state, lp_solver);
         return false;
     } else {
+        if (incremental) {
+            activate_cycle_constraints(ancestor_state, lp_solver);
+        }
         return add_cycle_constraints_implicit_hitting_set_approach(
             ancestor_state, lp_solver);
     }
 }
 
+void LandmarkConstraints::activate_cycle_constraints(
+    const State &ancestor_state, lp::LPSolver &lp_solver) {
+    /*
+      A cycle constraint is valid in all states in which all landmarks of
+      the cycle are future landmarks, because the orderings between them
+      do not depend on the state. Otherwise it is relaxed to 0.
+    */
+    int num_landmarks = static_cast<int>(lm_graph->get_number_of_landmarks());
+    int num_cycles = static_cast<int>(cycles.size());
+    for (int i = 0; i < num_cycles; ++i) {
+        bool cycle_active = all_of(
+            cycles[i].begin(), cycles[i].end(), [&](int id) {
+                return lm_status_manager->get_landmark_status(
+                    ancestor_state, id) == landmarks::FUTURE;
+            });
+        double lower_bound = cycle_active ? cycles[i].size() + 1.0 : 0.0;
+        lp_solver.set_constraint_lower_bound(
+            num_landmarks + i, lower_bound);
+    }
+}
+
+vector<BitsetMath::Word> LandmarkConstraints::compute_future_landmark_words(
+    const State &ancestor_state) const {
+    /*
+      Words of the landmarks with status FUTURE, i.e., future but not past.
+      The past bitset only covers the landmarks up to the last relevant
+      past id, so its last word may contain bits without meaning.
+    */
+    const BitsetView past = lm_status_manager->get_past_landmarks(ancestor_state);
+    const BitsetView fut = lm_status_manager->get_future_landmarks(ancestor_state);
+    int num_past_words = past.num_words();
+    vector<BitsetMath::Word> words(fut.num_words());
+    for (int w = 0; w < fut.num_words(); ++w) {
+        BitsetMath::Word past_word = 0;
+        if (w < num_past_words) {
+            past_word = past.get_word(w);
+            if (w == num_past_words - 1) {
+                int used_bits = past.size() - w * BitsetMath::bits_per_word;
+                if (used_bits < BitsetMath::bits_per_word) {
+                    past_word &= (BitsetMath::Word(1) << used_bits) - 1;
+                }
+            }
+        }
+        words[w] = fut.get_word(w) & ~past_word;
+    }
+    return words;
+}
+
 bool LandmarkConstraints::add_cycle_constraints_implicit_hitting_set_approach(
     const State &ancestor_state, lp::LPSolver &lp_solver) {
-    TypedAdjacencyList adj = compute_typed_adj_list(
-        ancestor_state, lm_graph, lm_status_manager);
-    shared_ptr<CycleOracle> oracle;
-    switch (cycle_generator) {
-    case CycleGenerator::FLOYD_WARSHALL:
-        oracle = make_shared<FloydWarshallOracle>(adj, !strong);
-        break;
-    case CycleGenerator::DEPTH_FIRST:
-        oracle = make_shared<DepthFirstOracle>(adj, !strong);
-        break;
-    default:
-        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    vector<BitsetMath::Word> future_landmarks;
+    if (cycle_pool) {
+        future_landmarks = compute_future_landmark_words(ancestor_state);
     }
+    /*
+      The oracle is only built once the pool contains no violated cycle,
+      because computing the adjacency list is expensive.
+    */
+    unique_ptr<CycleOracle> oracle;
 
     vector<int> cycle;
     for (size_t iteration = 0; /* TODO: max iterations? */; ++iteration) {
@@ -230,13 +288,59 @@ bool LandmarkConstraints::add_cycle_constraints_implicit_hitting_set_approach(
         }
         vector<float> lm_count =
             compute_landmark_weights(lm_graph, lp_solver.extract_solution());
-        cycle = oracle->find_cycle(lm_count);
+        cycle.clear();
+        if (cycle_pool) {
+            cycle = cycle_pool->find_violated_cycle(future_landmarks, lm_count);
+        }
         if (cycle.empty()) {
-            return false;
+            if (!oracle) {
+                TypedAdjacencyList adj = compute_typed_adj_list(
+                    ancestor_state, lm_graph, lm_status_manager);
+                switch (cycle_generator) {
+                case CycleGenerator::FLOYD_WARSHALL:
+                    oracle = utils::make_unique_ptr<FloydWarshallOracle>(
+                        adj, !strong);
+                    break;
+                case CycleGenerator::DEPTH_FIRST:
+                    oracle = utils::make_unique_ptr<DepthFirstOracle>(
+                        adj, !strong);
+                    break;
+                default:
+                    utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+                }
+            }
+            cycle = oracle->find_cycle(lm_count);
+            if (cycle.empty()) {
+                return false;
+            }
+            if (cycle_pool) {
+                cycle_pool->insert(cycle);
+            }
         }
         lp::LPConstraint constraint =
             compute_constraint(cycle, lp_solver.get_infinity());
-        lp_solver.add_temporary_constraints({constraint});
+        if (incremental) {
+            vector<int> sorted_cycle(cycle);
+            sort(sorted_cycle.begin(), sorted_cycle.end());
+            if (!sorted_cycles.insert(sorted_cycle).second) {
+                /*
+                  The constraint of this cycle is active already, so the
+                  solution violates it only within the numerical tolerance.
+                */
+                return false;
+            }
+            cycles.push_back(cycle);
+            lp_solver.add_permanent_constraints({constraint});
+        } else {
+            lp_solver.add_temporary_constraints({constraint});
+        }
+    }
+}
+
+void LandmarkConstraints::print_statistics(utils::LogProxy &log) const {
+    log << "Cycle constraints in the LP: " << cycles.size() << endl;
+    if (cycle_pool) {
+        cycle_pool->print_statistics(log);
     }
 }
 
@@ -250,6 +354,25 @@ void LandmarkConstraints::add_options_to_feature(plugins::Feature &feature) {
         "use observation that predecessors of strong orderings are not "
         "candidates to be reached twice within a cycle.",
         "true");
+    feature.add_option<bool>(
+        "incremental",
+        "keep the constraints of the cycles found by the oracle in the LP for "
+        "all later states instead of removing them after each evaluation. "
+        "They are switched on and off through their lower bounds depending "
+        "on whether all landmarks of the cycle are future landmarks, so the "
+        "LP solver can reuse its basis and the same cycles need not be found "
+        "again. Has no effect with cycle_generator=johnson or none.",
+        "false");
+    feature.add_option<int>(
+        "cycle_pool_size",
+        "maximum number of cycles found by the oracle that are kept across "
+        "states. Before the oracle is run, the pool is searched for a cycle "
+        "whose landmarks are all future landmarks and whose constraint is "
+        "violated by the current LP solution. If the pool is full, the least "
+        "recently used cycle is evicted. Use 0 to disable the pool. Has no "
+        "effect with incremental=true or cycle_generator=johnson or none.",
+        "0",
+        plugins::Bounds("0", "infinity"));
 }
 
 static plugins::TypedEnumPlugin<CycleGenerator> _enum_plugin({
@@ -4,15 +4,23 @@
 #include "constraint_generator.h"
 
 #include "../lp/lp_solver.h"
+#include "../per_state_bitset.h"
 #include "../plugins/options.h"
+#include "../utils/hash.h"
 
+#include <memory>
 #include <set>
 
 namespace landmarks {
-class DisjunctiveActionLandmarkGraph;
+class CompactDisjunctiveActionLandmarkGraph;
+class CyclePool;
 class DisjunctiveActionLandmarkStatusManager;
 }
 
+namespace utils {
+class LogProxy;
+}
+
 namespace operator_counting {
 enum class CycleGenerator {
     NONE,
@@ -25,12 +33,25 @@ enum class CycleGenerator {
 class LandmarkConstraints : public ConstraintGenerator {
     CycleGenerator cycle_generator;
     const bool strong;
-    const std::shared_ptr<landmarks::DisjunctiveActionLandmarkGraph> lm_graph;
+    const bool incremental;
+    const std::shared_ptr<landmarks::CompactDisjunctiveActionLandmarkGraph> lm_graph;
     const std::shared_ptr<landmarks::DisjunctiveActionLandmarkStatusManager> lm_status_manager;
     //static lp::LPConstraint compute_constraint(
     //    const std::set<int> &actions, double infinity);
 
+    /*
+      Cycles with a constraint in the LP: row num_landmarks + i belongs to
+      cycles[i]. With Johnson's algorithm, these are all elementary cycles
+      of the initial state. In incremental mode, the cycles found by an
+      oracle are added here and kept for all later states.
+    */
     std::vector<std::vector<int>> cycles;
+    utils::HashSet<std::vector<int>> sorted_cycles;
+    /*
+      Cycles found by the oracle in earlier states, checked before the
+      oracle is asked for a new cycle (only without incremental mode).
+    */
+    std::unique_ptr<landmarks::CyclePool> cycle_pool;
 
     void add_landmark_constraints(
         named_vector::NamedVector<lp::LPConstraint> &constraints,
@@ -49,20 +70,27 @@ class LandmarkConstraints : public ConstraintGenerator {
                                      lp::LPSolver &lp_solver);
     bool update_cycle_constraints(const State &ancestor_state,
                                   lp::LPSolver &lp_solver);
+    void activate_cycle_constraints(const State &ancestor_state,
+                                    lp::LPSolver &lp_solver);
+    std::vector<BitsetMath::Word> compute_future_landmark_words(
+        const State &ancestor_state) const;
     bool add_cycle_constraints_implicit_hitting_set_approach(
         const State &ancestor_state, lp::LPSolver &lp_solver);
 
 public:
     LandmarkConstraints(
         const plugins::Options &options,
-        const std::shared_ptr<landmarks::DisjunctiveActionLandmarkGraph> &lm_graph,
+        const std::shared_ptr<landmarks::CompactDisjunctiveActionLandmarkGraph> &lm_graph,
         const std::shared_ptr<landmarks::DisjunctiveActionLandmarkStatusManager> &lm_status_manager);
+    virtual ~LandmarkConstraints() override;
     virtual void initialize_constraints(
         const std::shared_ptr<AbstractTask> &task,
         lp::LinearProgram &lp) override;
     virtual bool update_constraints(
         const State &state, lp::LPSolver &lp_solver) override;
 
+    void print_statistics(utils::LogProxy &log) const;
+
     static void add_options_to_feature(plugins::Feature &feature);
 };
 }
@@ -1,5 +1,9 @@
 #include "per_state_bitset.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 using namespace std;
 
 
@@ -19,6 +23,18 @@ BitsetMath::Block BitsetMath::bit_mask(size_t pos) {
     return Block(1) << bit_index(pos);
 }
 
+int BitsetMath::compute_num_words(size_t num_bits) {
+    return (num_bits + bits_per_word - 1) / bits_per_word;
+}
+
+size_t BitsetMath::word_index(size_t pos) {
+    return pos / bits_per_word;
+}
+
+BitsetMath::Word BitsetMath::word_bit_mask(size_t pos) {
+    return Word(1) << (pos % bits_per_word);
+}
+
 
 BitsetView::BitsetView(ArrayView<BitsetMath::Block> data, int num_bits) :
     data(data), num_bits(num_bits) {}
@@ -65,6 +81,46 @@ int BitsetView::size() const {
     return num_bits;
 }
 
+int BitsetView::num_words() const {
+    return BitsetMath::compute_num_words(num_bits);
+}
+
+/*
+  We assemble words with memcpy, which compilers translate into single
+  (unaligned) loads and stores. This relies on a little-endian layout to
+  match the bit numbering of set() and test(); on big-endian machines we
+  fall back to assembling the word block by block.
+*/
+BitsetMath::Word BitsetView::get_word(int word_index) const {
+    assert(word_index >= 0 && word_index < num_words());
+    int first_block = word_index * BitsetMath::blocks_per_word;
+    int num_blocks = min(BitsetMath::blocks_per_word, data.size() - first_block);
+    BitsetMath::Word word = 0;
+    if constexpr (endian::native == endian::little) {
+        memcpy(&word, &data[first_block], num_blocks * sizeof(BitsetMath::Block));
+    } else {
+        for (int i = 0; i < num_blocks; ++i) {
+            word |= static_cast<BitsetMath::Word>(data[first_block + i])
+                << (i * BitsetMath::bits_per_block);
+        }
+    }
+    return word;
+}
+
+void BitsetView::set_word(int word_index, BitsetMath::Word word) {
+    assert(word_index >= 0 && word_index < num_words());
+    int first_block = word_index * BitsetMath::blocks_per_word;
+    int num_blocks = min(BitsetMath::blocks_per_word, data.size() - first_block);
+    if constexpr (endian::native == endian::little) {
+        memcpy(&data[first_block], &word, num_blocks * sizeof(BitsetMath::Block));
+    } else {
+        for (int i = 0; i < num_blocks; ++i) {
+            data[first_block + i] = static_cast<BitsetMath::Block>(
+                word >> (i * BitsetMath::bits_per_block));
+        }
+    }
+}
+
 
 static vector<BitsetMath::Block> pack_bit_vector(const vector<bool> &bits) {
     int num_bits = bits.size();
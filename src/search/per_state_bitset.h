@@ -3,6 +3,7 @@
 
 #include "per_state_array.h"
 
+#include <cstdint>
 #include <vector>
 
 
@@ -18,10 +19,26 @@ public:
     static const Block ones = Block(~Block(0));
     static const int bits_per_block = std::numeric_limits<Block>::digits;
 
+    /*
+      Words are used for word-parallel operations on bitsets. They are
+      assembled from consecutive blocks, so the storage layout of bitsets
+      is independent of the word size.
+    */
+    using Word = std::uint64_t;
+    static const int bits_per_word = std::numeric_limits<Word>::digits;
+    static const int blocks_per_word = bits_per_word / bits_per_block;
+    static_assert(
+        bits_per_word % bits_per_block == 0,
+        "Word size must be a multiple of the block size");
+
     static int compute_num_blocks(std::size_t num_bits);
     static std::size_t block_index(std::size_t pos);
     static std::size_t bit_index(std::size_t pos);
     static Block bit_mask(std::size_t pos);
+
+    static int compute_num_words(std::size_t num_bits);
+    static std::size_t word_index(std::size_t pos);
+    static Word word_bit_mask(std::size_t pos);
 };
 
 
@@ -41,6 +58,15 @@ public:
     bool test(int index) const;
     void intersect(const BitsetView &other);
     int size() const;
+
+    /*
+      Word-level access. Bit i of word w corresponds to index
+      w * BitsetMath::bits_per_word + i. Bits of the last word beyond
+      size() carry no information and should be ignored by callers.
+    */
+    int num_words() const;
+    BitsetMath::Word get_word(int word_index) const;
+    void set_word(int word_index, BitsetMath::Word word);
 };
 
 
@@ -1,6 +1,7 @@
 #include "command_line.h"
 #include "search_engine.h"
 
+#include "algorithms/segment_storage.h"
 #include "tasks/root_task.h"
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
@@ -39,6 +40,10 @@ int main(int argc, const char **argv) {
 
     engine->save_plan_if_necessary();
     engine->print_statistics();
+    if (segmented_vector::get_mapped_segment_storage()) {
+        segmented_vector::get_mapped_segment_storage()->print_statistics(
+            utils::g_log);
+    }
     utils::g_log << "Search time: " << search_timer << endl;
     utils::g_log << "Total time: " << utils::g_timer << endl;
 
@@ -49,7 +49,7 @@ SearchEngine::SearchEngine(const plugins::Options &opts)
       log(utils::get_log_from_options(opts)),
       state_registry(task_proxy),
       successor_generator(get_successor_generator(task_proxy, log)),
-      search_space(state_registry, log),
+      search_space(state_registry, opts.get<OperatorCost>("cost_type"), log),
       statistics(log),
       cost_type(opts.get<OperatorCost>("cost_type")),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
@@ -6,7 +6,7 @@
 #include "../pruning_method.h"
 
 #include "../algorithms/ordered_set.h"
-#include "../plugins/options.h"
+#include "../plugins/plugin.h"
 #include "../task_utils/successor_generator.h"
 #include "../utils/logging.h"
 
@@ -22,6 +22,7 @@ namespace eager_search {
 EagerSearch::EagerSearch(const plugins::Options &opts)
     : SearchEngine(opts),
       reopen_closed_nodes(opts.get<bool>("reopen_closed")),
+      batch_evaluation(opts.get<bool>("batch_evaluation")),
       open_list(opts.get<shared_ptr<OpenListFactory>>("open")->
                 create_state_open_list()),
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
@@ -104,6 +105,9 @@ void EagerSearch::initialize() {
 void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    for (const Evaluator *evaluator : path_dependent_evaluators) {
+        evaluator->print_statistics();
+    }
     pruning_method->print_statistics();
 }
 
@@ -189,12 +193,22 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
+    const vector<State> *evaluation_batch = nullptr;
+    if (batch_evaluation) {
+        generate_successors_for_batch(s, node->get_real_g(), applicable_ops);
+        if (new_successor_states.size() >= 2)
+            evaluation_batch = &new_successor_states;
+    }
+
+    size_t num_successors = 0;
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         if ((node->get_real_g() + op.get_cost()) >= bound)
             continue;
 
-        State succ_state = state_registry.get_successor_state(s, op);
+        State succ_state = batch_evaluation ?
+            state_registry.lookup_state(successor_ids[num_successors++]) :
+            state_registry.get_successor_state(s, op);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -219,6 +233,7 @@ SearchStatus EagerSearch::step() {
 
             EvaluationContext succ_eval_context(
                 succ_state, succ_g, is_preferred, &statistics);
+            succ_eval_context.set_evaluation_batch(evaluation_batch);
             statistics.inc_evaluated_states();
 
             if (open_list->is_dead_end(succ_eval_context)) {
@@ -307,7 +322,37 @@ void EagerSearch::update_f_value_statistics(EvaluationContext &eval_context) {
     }
 }
 
+void EagerSearch::generate_successors_for_batch(
+    const State &s, int real_g, const vector<OperatorID> &applicable_ops) {
+    successor_ids.clear();
+    new_successor_states.clear();
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        if ((real_g + op.get_cost()) >= bound)
+            continue;
+
+        size_t num_registered_states = state_registry.size();
+        State succ_state = state_registry.get_successor_state(s, op);
+        successor_ids.push_back(succ_state.get_id());
+        /*
+          The data of a state that was registered before is only valid
+          until the next successor is generated, so we only keep new
+          states here.
+        */
+        if (state_registry.size() > num_registered_states)
+            new_successor_states.push_back(move(succ_state));
+    }
+}
+
 void add_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "batch_evaluation",
+        "generate all successor states of a state when it is expanded and "
+        "let heuristics that support batch evaluation (see their "
+        "batch_evaluation options) compute the estimates of the new ones "
+        "at once. This does not change the estimates or the search "
+        "behavior.",
+        "false");
     SearchEngine::add_pruning_option(feature);
     SearchEngine::add_options_to_feature(feature);
 }
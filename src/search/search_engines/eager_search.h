@@ -17,6 +17,7 @@ class Feature;
 namespace eager_search {
 class EagerSearch : public SearchEngine {
     const bool reopen_closed_nodes;
+    const bool batch_evaluation;
 
     std::unique_ptr<StateOpenList> open_list;
     std::shared_ptr<Evaluator> f_evaluator;
@@ -27,6 +28,20 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    /*
+      With batch evaluation, we register all successors of the expanded
+      state before evaluating any of them. successor_ids holds their IDs
+      in the order of the applicable operators (skipping those exceeding
+      the bound) and new_successor_states the states registered for the
+      first time, which form the evaluation batch.
+    */
+    std::vector<StateID> successor_ids;
+    std::vector<State> new_successor_states;
+
+    void generate_successors_for_batch(
+        const State &s, int real_g,
+        const std::vector<OperatorID> &applicable_ops);
+
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
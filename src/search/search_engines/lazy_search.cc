@@ -3,10 +3,12 @@
 #include "../open_list_factory.h"
 
 #include "../algorithms/ordered_set.h"
-#include "../plugins/options.h"
+#include "../plugins/plugin.h"
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
+#include "../utils/hash.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -17,6 +19,19 @@
 using namespace std;
 
 namespace lazy_search {
+/*
+  The closed-state filter starts with 256 blocks (8 KB) and is rebuilt with
+  twice as many blocks whenever it holds more than one value per 16 bits.
+*/
+static const size_t INITIAL_FILTER_BLOCKS = 256;
+static const size_t FILTER_BITS_PER_VALUE = 16;
+
+static uint64_t get_filter_hash(const PackedStateBin *buffer, int num_bins) {
+    utils::HashState hash_state;
+    hash_state.feed_values(buffer, num_bins);
+    return hash_state.get_hash64();
+}
+
 LazySearch::LazySearch(const plugins::Options &opts)
     : SearchEngine(opts),
       open_list(opts.get<shared_ptr<OpenListFactory>>("open")->
@@ -24,7 +39,11 @@ LazySearch::LazySearch(const plugins::Options &opts)
       reopen_closed_nodes(opts.get<bool>("reopen_closed")),
       randomize_successors(opts.get<bool>("randomize_successors")),
       preferred_successors_first(opts.get<bool>("preferred_successors_first")),
+      batch_progression(opts.get<bool>("batch_progression")),
       rng(utils::parse_rng_from_options(opts)),
+      num_filter_queries(0),
+      num_filter_false_positives(0),
+      num_suppressed_edges(0),
       current_state(state_registry.get_initial_state()),
       current_predecessor_id(StateID::no_state),
       current_operator_id(OperatorID::no_operator),
@@ -35,6 +54,19 @@ LazySearch::LazySearch(const plugins::Options &opts)
       We initialize current_eval_context in such a way that the initial node
       counts as "preferred".
     */
+    if (opts.get<bool>("closed_state_filter")) {
+        if (task_properties::has_axioms(task_proxy)) {
+            if (log.is_warning()) {
+                log << "Warning: the closed-state filter does not support "
+                    << "axioms and is disabled" << endl;
+            }
+        } else {
+            closed_state_filter =
+                utils::make_unique_ptr<blocked_bloom_filter::BlockedBloomFilter>(
+                    INITIAL_FILTER_BLOCKS);
+            successor_buffer.resize(state_registry.get_bins_per_state());
+        }
+    }
 }
 
 void LazySearch::set_preferred_operator_evaluators(
@@ -102,15 +134,40 @@ void LazySearch::generate_successors() {
 
     statistics.inc_generated(successor_operators.size());
 
+    vector<OperatorID> notified_operators;
+    vector<StateID> successor_ids;
     for (OperatorID op_id : successor_operators) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         int new_g = current_g + get_adjusted_cost(op);
         int new_real_g = current_real_g + op.get_cost();
         bool is_preferred = preferred_operators.contains(op_id);
         if (new_real_g < bound) {
-            EvaluationContext new_eval_context(
-                current_eval_context, new_g, is_preferred, nullptr);
-            open_list->insert(new_eval_context, make_pair(current_state.get_id(), op_id));
+            if (!closed_state_filter || !is_edge_to_closed_state(op, new_g)) {
+                EvaluationContext new_eval_context(
+                    current_eval_context, new_g, is_preferred, nullptr);
+                open_list->insert(new_eval_context, make_pair(current_state.get_id(), op_id));
+            }
+            if (batch_progression && !path_dependent_evaluators.empty()) {
+                notified_operators.push_back(op_id);
+                successor_ids.push_back(
+                    state_registry.get_successor_state(current_state, op).get_id());
+            }
+        }
+    }
+    if (!notified_operators.empty()) {
+        /*
+          A state returned by get_successor_state is only valid until the
+          next state is registered if it was registered before, so we look
+          up the successors once all of them are registered.
+        */
+        vector<State> successor_states;
+        successor_states.reserve(successor_ids.size());
+        for (StateID id : successor_ids) {
+            successor_states.push_back(state_registry.lookup_state(id));
+        }
+        for (Evaluator *evaluator : path_dependent_evaluators) {
+            evaluator->notify_state_transitions(
+                current_state, notified_operators, successor_states);
         }
     }
 }
@@ -129,6 +186,15 @@ SearchStatus LazySearch::fetch_next_state() {
     OperatorProxy current_operator = task_proxy.get_operators()[current_operator_id];
     assert(task_properties::is_applicable(current_operator, current_predecessor));
     current_state = state_registry.get_successor_state(current_predecessor, current_operator);
+    if (batch_progression || closed_state_filter) {
+        /*
+          If the state was registered before (e.g., when its parent was
+          expanded with batch progression), the returned state refers to
+          the popped end of the state data pool, which is overwritten when
+          the successors of the state are registered or looked up.
+        */
+        current_state = state_registry.lookup_state(current_state.get_id());
+    }
 
     SearchNode pred_node = search_space.get_node(current_predecessor);
     current_g = pred_node.get_g() + get_adjusted_cost(current_operator);
@@ -161,7 +227,8 @@ SearchStatus LazySearch::step() {
         !node.is_dead_end() && (current_g < node.get_g());
 
     if (node.is_new() || reopen) {
-        if (current_operator_id != OperatorID::no_operator) {
+        if (current_operator_id != OperatorID::no_operator
+            && !batch_progression) {
             assert(current_predecessor_id != StateID::no_state);
             if (!path_dependent_evaluators.empty()) {
                 State parent_state = state_registry.lookup_state(current_predecessor_id);
@@ -189,6 +256,9 @@ SearchStatus LazySearch::step() {
                 }
             }
             node.close();
+            if (closed_state_filter) {
+                insert_into_closed_state_filter(current_state);
+            }
             if (check_goal_and_set_plan(current_state))
                 return SOLVED;
             if (search_progress.check_progress(current_eval_context)) {
@@ -200,6 +270,9 @@ SearchStatus LazySearch::step() {
         } else {
             node.mark_as_dead_end();
             statistics.inc_dead_ends();
+            if (closed_state_filter) {
+                insert_into_closed_state_filter(current_state);
+            }
         }
         if (current_predecessor_id == StateID::no_state) {
             print_initial_evaluator_values(current_eval_context);
@@ -212,8 +285,97 @@ void LazySearch::reward_progress() {
     open_list->boost_preferred();
 }
 
+void LazySearch::insert_into_closed_state_filter(const State &state) {
+    int num_bins = state_registry.get_bins_per_state();
+    if ((closed_state_filter->size() + 1) * FILTER_BITS_PER_VALUE <=
+        closed_state_filter->get_num_bits()) {
+        closed_state_filter->insert(get_filter_hash(state.get_buffer(), num_bins));
+    } else {
+        /*
+          The filter cannot enumerate its values, so we rebuild it from the
+          closed and dead-end states in the registry, which include the
+          given state.
+        */
+        closed_state_filter->clear(2 * closed_state_filter->get_num_blocks());
+        for (StateID id : state_registry) {
+            State registered_state = state_registry.lookup_state(id);
+            SearchNode node = search_space.get_node(registered_state);
+            if (node.is_closed() || node.is_dead_end()) {
+                closed_state_filter->insert(
+                    get_filter_hash(registered_state.get_buffer(), num_bins));
+            }
+        }
+    }
+}
+
+bool LazySearch::is_edge_to_closed_state(const OperatorProxy &op, int new_g) {
+    ++num_filter_queries;
+    PackedStateBin *buffer = successor_buffer.data();
+    state_registry.compute_successor_data(current_state, op, buffer);
+    if (!closed_state_filter->may_contain(
+            get_filter_hash(buffer, state_registry.get_bins_per_state()))) {
+        return false;
+    }
+    StateID id = state_registry.find_state_id(buffer);
+    if (id != StateID::no_state) {
+        SearchNode node = search_space.get_node(state_registry.lookup_state(id));
+        if (node.is_dead_end()) {
+            ++num_suppressed_edges;
+            return true;
+        } else if (node.is_closed()) {
+            // Keep edges that would reopen the state (see step()).
+            if (reopen_closed_nodes && new_g < node.get_g()) {
+                return false;
+            }
+            ++num_suppressed_edges;
+            return true;
+        }
+    }
+    ++num_filter_false_positives;
+    return false;
+}
+
+void LazySearch::add_batch_progression_option(plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "batch_progression",
+        "generate the successor states of a state when it is expanded and "
+        "notify path-dependent evaluators (e.g., landmark heuristics) of all "
+        "its transitions at once. This lets them share work between the "
+        "successors, but stores all generated states in the state registry "
+        "and also notifies them of transitions that are never removed from "
+        "the open list.",
+        "false");
+}
+
+void LazySearch::add_closed_state_filter_option(plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "closed_state_filter",
+        "do not insert edges into the open list that lead to states which "
+        "are already closed. To detect such edges cheaply, the successor "
+        "state of each edge is computed when the edge is generated and "
+        "looked up in a Bloom filter of the closed states. Only edges that "
+        "the search would skip when removing them from the open list are "
+        "suppressed, but open lists that alternate between sub-lists may "
+        "select edges in a different order. The filter is not supported "
+        "for tasks with axioms.",
+        "false");
+}
+
 void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    if (closed_state_filter) {
+        int num_negatives = num_filter_queries - num_suppressed_edges;
+        log << "Closed-state filter: " << num_filter_queries << " queries, "
+            << num_suppressed_edges << " suppressed edges, "
+            << num_filter_false_positives << " false positives (rate "
+            << (num_negatives ? 100.0 * num_filter_false_positives / num_negatives : 0.0)
+            << "% of unsuppressed edges), "
+            << closed_state_filter->estimate_memory_in_bytes() / 1024 << " KB"
+            << endl;
+    }
+    for (const Evaluator *evaluator : path_dependent_evaluators) {
+        evaluator->print_statistics();
+    }
 }
 }
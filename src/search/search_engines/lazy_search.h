@@ -9,6 +9,7 @@
 #include "../search_progress.h"
 #include "../search_space.h"
 
+#include "../algorithms/blocked_bloom_filter.h"
 #include "../utils/rng.h"
 
 #include <memory>
@@ -23,8 +24,30 @@ protected:
     bool reopen_closed_nodes; // whether to reopen closed nodes upon finding lower g paths
     bool randomize_successors;
     bool preferred_successors_first;
+    /*
+      If true, successor states are generated when their parent is expanded
+      and path-dependent evaluators are notified of all transitions of the
+      parent at once, instead of one by one when an edge is removed from the
+      open list.
+    */
+    bool batch_progression;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
+    /*
+      If the closed-state filter is used, edges to states that are
+      already closed (or dead ends) when the edge is generated are not
+      inserted into the open list. The filter contains the hashes of all
+      closed states, so most edges to new states are recognized without
+      accessing the state registry. Edges that pass the filter are checked
+      against the registry and search space, so edges are only suppressed
+      if removing them from the open list would have no effect.
+    */
+    std::unique_ptr<blocked_bloom_filter::BlockedBloomFilter> closed_state_filter;
+    std::vector<PackedStateBin> successor_buffer;
+    int num_filter_queries;
+    int num_filter_false_positives;
+    int num_suppressed_edges;
+
     std::vector<Evaluator *> path_dependent_evaluators;
     std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
 
@@ -43,6 +66,9 @@ protected:
 
     void reward_progress();
 
+    void insert_into_closed_state_filter(const State &state);
+    bool is_edge_to_closed_state(const OperatorProxy &op, int new_g);
+
     std::vector<OperatorID> get_successor_operators(
         const ordered_set::OrderedSet<OperatorID> &preferred_operators) const;
 
@@ -52,6 +78,9 @@ public:
 
     void set_preferred_operator_evaluators(std::vector<std::shared_ptr<Evaluator>> &evaluators);
 
+    static void add_batch_progression_option(plugins::Feature &feature);
+    static void add_closed_state_filter_option(plugins::Feature &feature);
+
     virtual void print_statistics() const override;
 };
 }
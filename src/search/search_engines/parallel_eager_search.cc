@@ -0,0 +1,467 @@
+#include "parallel_eager_search.h"
+
+#include "search_common.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../per_state_information.h"
+
+#include "../parser/decorated_abstract_syntax_tree.h"
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/logging.h"
+#include "../utils/mpsc_queue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace parallel_eager_search {
+struct NodeInfo {
+    enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
+
+    NodeStatus status;
+    int g;
+    int real_g;
+    // The parent state is stored in the registry of this worker.
+    int parent_worker;
+    StateID parent_state_id;
+    OperatorID creating_operator;
+
+    NodeInfo()
+        : status(NEW), g(-1), real_g(-1), parent_worker(-1),
+          parent_state_id(StateID::no_state), creating_operator(-1) {
+    }
+};
+
+struct Successor {
+    int g;
+    int real_g;
+    int parent_worker;
+    StateID parent_state_id;
+    OperatorID creating_operator;
+
+    Successor(int g, int real_g, int parent_worker, StateID parent_state_id,
+              OperatorID creating_operator)
+        : g(g), real_g(real_g), parent_worker(parent_worker),
+          parent_state_id(parent_state_id),
+          creating_operator(creating_operator) {
+    }
+};
+
+/*
+  All successors that one worker sends to another after an expansion. The
+  packed data of the i-th successor starts at state_data[i * bins_per_state].
+*/
+struct MessageBatch {
+    vector<PackedStateBin> state_data;
+    vector<Successor> successors;
+};
+
+struct Worker {
+    const int id;
+    utils::LogProxy log;
+    SearchStatistics statistics;
+    StateRegistry state_registry;
+    PerStateInformation<NodeInfo> node_infos;
+    unique_ptr<StateOpenList> open_list;
+    shared_ptr<Evaluator> f_evaluator;
+
+    utils::MPSCQueue<MessageBatch> incoming_messages;
+    vector<MessageBatch> outgoing_messages;
+
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> successor_data;
+
+    Worker(int id, int num_workers, const TaskProxy &task_proxy,
+           const shared_ptr<OpenListFactory> &open_list_factory,
+           const shared_ptr<Evaluator> &f_evaluator)
+        : id(id),
+          log(utils::get_silent_log()),
+          statistics(log),
+          state_registry(task_proxy),
+          open_list(open_list_factory->create_state_open_list()),
+          f_evaluator(f_evaluator),
+          outgoing_messages(num_workers),
+          successor_data(state_registry.get_bins_per_state()) {
+    }
+};
+
+/*
+  Evaluators keep per-state data and caches, so every worker needs its
+  own instances. We therefore construct the (lazily parsed) evaluators once
+  per worker. Evaluators that are bound to a variable outside of the
+  evaluator arguments are constructed only once and would be shared.
+*/
+static pair<shared_ptr<OpenListFactory>, shared_ptr<Evaluator>>
+create_open_list_factory_and_f_eval(const plugins::Options &opts) {
+    plugins::Options worker_opts(opts);
+    if (opts.contains("eval")) {
+        worker_opts.set("eval", opts.get<parser::LazyValue>("eval").
+                        construct<shared_ptr<Evaluator>>());
+        return search_common::create_astar_open_list_factory_and_f_eval(
+            worker_opts);
+    } else {
+        worker_opts.set("evals", opts.get<parser::LazyValue>("evals").
+                        construct<vector<shared_ptr<Evaluator>>>());
+        worker_opts.set("preferred", vector<shared_ptr<Evaluator>>());
+        worker_opts.set("boost", 0);
+        return make_pair(
+            search_common::create_greedy_open_list_factory(worker_opts),
+            nullptr);
+    }
+}
+
+ParallelEagerSearch::ParallelEagerSearch(const plugins::Options &opts)
+    : SearchEngine(opts),
+      num_workers(opts.get<int>("num_threads")),
+      reopen_closed_nodes(opts.get<bool>("reopen_closed")),
+      num_active_work_items(0),
+      terminated(false),
+      timed_out(false),
+      incumbent_cost(numeric_limits<int>::max()),
+      solution_worker(-1),
+      solution_state_id(StateID::no_state) {
+    /*
+      The axiom evaluator is shared by all registries of a task and
+      is not thread-safe.
+    */
+    task_properties::verify_no_axioms(task_proxy);
+
+    for (int i = 0; i < num_workers; ++i) {
+        auto open_list_factory_and_f_eval =
+            create_open_list_factory_and_f_eval(opts);
+        workers.push_back(utils::make_unique_ptr<Worker>(
+                              i, num_workers, task_proxy,
+                              open_list_factory_and_f_eval.first,
+                              open_list_factory_and_f_eval.second));
+        set<Evaluator *> path_dependent_evaluators;
+        workers.back()->open_list->get_path_dependent_evaluators(
+            path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "Parallel search does not support path-dependent "
+                 << "evaluators." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+    }
+}
+
+ParallelEagerSearch::~ParallelEagerSearch() {
+}
+
+int ParallelEagerSearch::get_owner(const PackedStateBin *buffer) const {
+    /*
+      The registries use the low bits of the hash to find buckets, so we
+      use the high bits to select the owner. Otherwise, all states of a
+      worker would share their low bits and crowd a fraction of the buckets.
+    */
+    uint64_t hash = state_registry.get_hash(buffer);
+    return static_cast<int>((hash * num_workers) >> 32);
+}
+
+void ParallelEagerSearch::initialize() {
+    log << "Conducting parallel best first search with " << num_workers
+        << " threads"
+        << (reopen_closed_nodes ? " with" : " without")
+        << " reopening closed nodes, (real) bound = " << bound
+        << endl;
+
+    const State &initial_state = state_registry.get_initial_state();
+    Worker &worker = *workers[get_owner(initial_state.get_buffer())];
+    State state = worker.state_registry.register_state_data(
+        initial_state.get_buffer());
+
+    /*
+      Note: we consider the initial state as reached by a preferred
+      operator.
+    */
+    EvaluationContext eval_context(state, 0, true, &worker.statistics);
+    worker.statistics.inc_evaluated_states();
+
+    if (worker.open_list->is_dead_end(eval_context)) {
+        log << "Initial state is a dead end." << endl;
+    } else {
+        NodeInfo &info = worker.node_infos[state];
+        info.status = NodeInfo::OPEN;
+        info.g = 0;
+        info.real_g = 0;
+        worker.open_list->insert(eval_context, state.get_id());
+    }
+
+    print_initial_evaluator_values(eval_context);
+}
+
+void ParallelEagerSearch::insert_state(
+    Worker &worker, const PackedStateBin *buffer, int g, int real_g,
+    int parent_worker, StateID parent_id, OperatorID op_id) {
+    State state = worker.state_registry.register_state_data(buffer);
+    NodeInfo &info = worker.node_infos[state];
+
+    // Previously encountered dead end. Don't re-evaluate.
+    if (info.status == NodeInfo::DEAD_END)
+        return;
+
+    bool is_new = info.status == NodeInfo::NEW;
+    if (!is_new && info.g <= g)
+        return;
+
+    if (!is_new && !reopen_closed_nodes) {
+        /*
+          We just update the parent pointers. As in eager search, this
+          can cause an incompatibility between the g-value and the actual
+          path that is traced back.
+        */
+        info.g = g;
+        info.real_g = real_g;
+        info.parent_worker = parent_worker;
+        info.parent_state_id = parent_id;
+        info.creating_operator = op_id;
+        return;
+    }
+
+    EvaluationContext eval_context(state, g, false, &worker.statistics);
+    if (is_new) {
+        worker.statistics.inc_evaluated_states();
+        if (worker.open_list->is_dead_end(eval_context)) {
+            info.status = NodeInfo::DEAD_END;
+            worker.statistics.inc_dead_ends();
+            return;
+        }
+    } else if (info.status == NodeInfo::CLOSED) {
+        worker.statistics.inc_reopened();
+    }
+
+    info.status = NodeInfo::OPEN;
+    info.g = g;
+    info.real_g = real_g;
+    info.parent_worker = parent_worker;
+    info.parent_state_id = parent_id;
+    info.creating_operator = op_id;
+
+    /*
+      States that cannot lead to a plan that is cheaper than the incumbent
+      keep their node information (so that a cheaper path to them is
+      recognized), but are not inserted.
+    */
+    if (worker.f_evaluator &&
+        eval_context.get_evaluator_value(worker.f_evaluator.get()) >=
+        incumbent_cost.load(memory_order_relaxed))
+        return;
+
+    worker.open_list->insert(eval_context, state.get_id());
+}
+
+void ParallelEagerSearch::receive_messages(Worker &worker) {
+    int bins_per_state = worker.state_registry.get_bins_per_state();
+    MessageBatch batch;
+    while (worker.incoming_messages.pop(batch)) {
+        for (size_t i = 0; i < batch.successors.size(); ++i) {
+            const Successor &succ = batch.successors[i];
+            insert_state(worker, &batch.state_data[i * bins_per_state],
+                         succ.g, succ.real_g, succ.parent_worker,
+                         succ.parent_state_id, succ.creating_operator);
+        }
+        // The message is processed, so it no longer keeps the search alive.
+        num_active_work_items.fetch_sub(1, memory_order_acq_rel);
+    }
+}
+
+void ParallelEagerSearch::send_messages(Worker &worker) {
+    for (int i = 0; i < num_workers; ++i) {
+        MessageBatch &batch = worker.outgoing_messages[i];
+        if (batch.successors.empty())
+            continue;
+        // Count the message before it becomes visible to the receiver.
+        num_active_work_items.fetch_add(1, memory_order_acq_rel);
+        workers[i]->incoming_messages.push(move(batch));
+        batch = MessageBatch();
+    }
+}
+
+void ParallelEagerSearch::report_solution(
+    Worker &worker, const State &state, int g) {
+    lock_guard<mutex> lock(solution_mutex);
+    if (g < incumbent_cost.load(memory_order_relaxed)) {
+        incumbent_cost.store(g, memory_order_relaxed);
+        solution_worker = worker.id;
+        solution_state_id = state.get_id();
+    }
+    // Without f evaluator, we stop at the first goal like eager search.
+    if (!worker.f_evaluator)
+        terminated.store(true, memory_order_relaxed);
+}
+
+void ParallelEagerSearch::expand_next_state(Worker &worker) {
+    StateID id = worker.open_list->remove_min();
+    State state = worker.state_registry.lookup_state(id);
+    NodeInfo &info = worker.node_infos[state];
+    if (info.status == NodeInfo::CLOSED)
+        return;
+
+    int g = info.g;
+    int real_g = info.real_g;
+    int incumbent = incumbent_cost.load(memory_order_relaxed);
+    if (worker.f_evaluator) {
+        EvaluationContext eval_context(state, g, false, &worker.statistics);
+        if (eval_context.get_evaluator_value(worker.f_evaluator.get()) >=
+            incumbent)
+            return;
+    }
+
+    info.status = NodeInfo::CLOSED;
+    worker.statistics.inc_expanded();
+
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        report_solution(worker, state, g);
+        return;
+    }
+
+    worker.applicable_ops.clear();
+    successor_generator.generate_applicable_ops(state, worker.applicable_ops);
+
+    PackedStateBin *buffer = worker.successor_data.data();
+    int bins_per_state = worker.state_registry.get_bins_per_state();
+    for (OperatorID op_id : worker.applicable_ops) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        if ((real_g + op.get_cost()) >= bound)
+            continue;
+        int succ_g = g + get_adjusted_cost(op);
+        // Evaluators are non-negative, so f >= g.
+        if (worker.f_evaluator && succ_g >= incumbent)
+            continue;
+
+        worker.state_registry.compute_successor_data(state, op, buffer);
+        worker.statistics.inc_generated();
+        int owner = get_owner(buffer);
+        if (owner == worker.id) {
+            insert_state(worker, buffer, succ_g, real_g + op.get_cost(),
+                         worker.id, id, op_id);
+        } else {
+            MessageBatch &batch = worker.outgoing_messages[owner];
+            batch.state_data.insert(
+                batch.state_data.end(), buffer, buffer + bins_per_state);
+            batch.successors.emplace_back(
+                succ_g, real_g + op.get_cost(), worker.id, id, op_id);
+        }
+    }
+    send_messages(worker);
+}
+
+void ParallelEagerSearch::run_worker(
+    Worker &worker, const utils::CountdownTimer &timer) {
+    while (!terminated.load(memory_order_relaxed)) {
+        if (timer.is_expired()) {
+            timed_out.store(true, memory_order_relaxed);
+            terminated.store(true, memory_order_relaxed);
+            break;
+        }
+        receive_messages(worker);
+        if (!worker.open_list->empty()) {
+            expand_next_state(worker);
+            continue;
+        }
+
+        // Become idle until new messages arrive or the search is over.
+        num_active_work_items.fetch_sub(1, memory_order_acq_rel);
+        while (true) {
+            if (terminated.load(memory_order_relaxed))
+                return;
+            if (!worker.incoming_messages.empty()) {
+                num_active_work_items.fetch_add(1, memory_order_acq_rel);
+                break;
+            }
+            if (num_active_work_items.load(memory_order_acquire) == 0) {
+                terminated.store(true, memory_order_relaxed);
+                return;
+            }
+            this_thread::yield();
+        }
+    }
+}
+
+SearchStatus ParallelEagerSearch::step() {
+    utils::CountdownTimer timer(max_time);
+    num_active_work_items.store(num_workers);
+    vector<thread> threads;
+    threads.reserve(num_workers - 1);
+    for (int i = 1; i < num_workers; ++i) {
+        threads.emplace_back(
+            [this, i, &timer]() {run_worker(*workers[i], timer);});
+    }
+    run_worker(*workers[0], timer);
+    for (thread &t : threads) {
+        t.join();
+    }
+
+    for (const unique_ptr<Worker> &worker : workers) {
+        const SearchStatistics &worker_statistics = worker->statistics;
+        statistics.inc_expanded(worker_statistics.get_expanded());
+        statistics.inc_evaluated_states(worker_statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker_statistics.get_evaluations());
+        statistics.inc_generated(worker_statistics.get_generated());
+        statistics.inc_reopened(worker_statistics.get_reopened());
+        statistics.inc_dead_ends(worker_statistics.get_dead_ends());
+    }
+
+    /*
+      With an f evaluator, the incumbent plan is only known to be optimal
+      if the search ran until all workers became idle.
+    */
+    bool optimal_search = workers[0]->f_evaluator != nullptr;
+    if (solution_worker != -1 && !(optimal_search && timed_out)) {
+        log << "Solution found!" << endl;
+        trace_plan();
+        return SOLVED;
+    } else if (timed_out) {
+        return TIMEOUT;
+    }
+    log << "Completely explored state space -- no solution!" << endl;
+    return FAILED;
+}
+
+void ParallelEagerSearch::trace_plan() {
+    Plan plan;
+    int worker_id = solution_worker;
+    StateID state_id = solution_state_id;
+    while (true) {
+        Worker &worker = *workers[worker_id];
+        State state = worker.state_registry.lookup_state(state_id);
+        const NodeInfo &info = worker.node_infos[state];
+        if (info.creating_operator == OperatorID::no_operator) {
+            assert(info.parent_state_id == StateID::no_state);
+            break;
+        }
+        plan.push_back(info.creating_operator);
+        worker_id = info.parent_worker;
+        state_id = info.parent_state_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+void ParallelEagerSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    for (const unique_ptr<Worker> &worker : workers) {
+        log << "Worker " << worker->id << ": expanded "
+            << worker->statistics.get_expanded() << " state(s), registered "
+            << worker->state_registry.size() << " state(s)." << endl;
+    }
+}
+
+void add_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "num_threads",
+        "number of worker threads, each owning a partition of the state space",
+        "1",
+        plugins::Bounds("1", "infinity"));
+    SearchEngine::add_options_to_feature(feature);
+}
+}
@@ -0,0 +1,88 @@
+#ifndef SEARCH_ENGINES_PARALLEL_EAGER_SEARCH_H
+#define SEARCH_ENGINES_PARALLEL_EAGER_SEARCH_H
+
+#include "../search_engine.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace plugins {
+class Feature;
+}
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace parallel_eager_search {
+struct Worker;
+
+/*
+  Hash-distributed best-first search (HDA*, Kishimoto et al., 2009).
+
+  The state space is partitioned over a number of workers running in
+  separate threads. Each state is owned by the worker selected by its hash
+  value in the StateRegistry. Every worker has its own state registry, open
+  list, search node information and evaluator instances, and only ever
+  touches its own states. When a worker expands a state, it computes the
+  packed successor states and sends them (together with their g values and
+  parent pointers) to their owners through lock-free message queues. The
+  owner detects duplicates, evaluates new states and inserts them into its
+  open list.
+
+  Parent pointers consist of the parent's worker and its ID in that
+  worker's registry, so plans are traced across partitions once all
+  workers have stopped.
+
+  The search terminates when a worker expands a goal state, or, if an
+  f evaluator is used (A*), when no worker has open states with f values
+  below the cost of the best plan found so far and no messages are in
+  flight. To detect this, we count the workers that are busy plus the
+  messages that have been sent but not processed yet. Workers only
+  increase the counter while they are counted themselves, so once the
+  counter drops to zero, all workers are idle and stay idle.
+*/
+class ParallelEagerSearch : public SearchEngine {
+    const int num_workers;
+    const bool reopen_closed_nodes;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::atomic<int> num_active_work_items;
+    std::atomic<bool> terminated;
+    std::atomic<bool> timed_out;
+
+    std::mutex solution_mutex;
+    std::atomic<int> incumbent_cost;
+    int solution_worker;
+    StateID solution_state_id;
+
+    int get_owner(const PackedStateBin *buffer) const;
+
+    void insert_state(Worker &worker, const PackedStateBin *buffer,
+                      int g, int real_g, int parent_worker,
+                      StateID parent_id, OperatorID op_id);
+    void receive_messages(Worker &worker);
+    void send_messages(Worker &worker);
+    void expand_next_state(Worker &worker);
+    void report_solution(Worker &worker, const State &state, int g);
+    void run_worker(Worker &worker, const utils::CountdownTimer &timer);
+
+    void trace_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ParallelEagerSearch(const plugins::Options &opts);
+    virtual ~ParallelEagerSearch() override;
+
+    virtual void print_statistics() const override;
+};
+
+extern void add_options_to_feature(plugins::Feature &feature);
+}
+
+#endif
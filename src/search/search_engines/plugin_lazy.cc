@@ -18,6 +18,8 @@ public:
             "preferred",
             "use preferred operators of these evaluators", "[]");
         SearchEngine::add_succ_order_options(*this);
+        lazy_search::LazySearch::add_batch_progression_option(*this);
+        lazy_search::LazySearch::add_closed_state_filter_option(*this);
         SearchEngine::add_options_to_feature(*this);
     }
 
@@ -31,6 +31,8 @@ public:
             "to preferred operator nodes",
             DEFAULT_LAZY_BOOST);
         SearchEngine::add_succ_order_options(*this);
+        lazy_search::LazySearch::add_batch_progression_option(*this);
+        lazy_search::LazySearch::add_closed_state_filter_option(*this);
         SearchEngine::add_options_to_feature(*this);
 
         document_note(
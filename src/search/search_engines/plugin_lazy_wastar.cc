@@ -32,6 +32,8 @@ public:
             DEFAULT_LAZY_BOOST);
         add_option<int>("w", "evaluator weight", "1");
         SearchEngine::add_succ_order_options(*this);
+        lazy_search::LazySearch::add_batch_progression_option(*this);
+        lazy_search::LazySearch::add_closed_state_filter_option(*this);
         SearchEngine::add_options_to_feature(*this);
 
         document_note(
@@ -0,0 +1,46 @@
+#include "parallel_eager_search.h"
+
+#include "../plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_parallel_astar {
+class ParallelAStarSearchFeature : public plugins::TypedFeature<SearchEngine, parallel_eager_search::ParallelEagerSearch> {
+public:
+    ParallelAStarSearchFeature() : TypedFeature("parallel_astar") {
+        document_title("Parallel A* search (HDA*)");
+        document_synopsis(
+            "Hash-distributed A* search: the states are partitioned over "
+            "worker threads by their hash values. Each worker runs A* on its "
+            "partition and sends generated states to their owners. "
+            "Closed nodes are re-opened, and the search continues until no "
+            "worker has a state whose f-value is below the cost of the best "
+            "plan found, so the plan is optimal for admissible evaluators.");
+
+        add_option<shared_ptr<Evaluator>>(
+            "eval", "evaluator for h-value", plugins::ArgumentInfo::NO_DEFAULT,
+            plugins::Bounds::unlimited(), true);
+        parallel_eager_search::add_options_to_feature(*this);
+
+        document_note(
+            "Evaluator instances",
+            "The evaluator is constructed once per thread. Evaluators that "
+            "are defined with let (or --evaluator) outside of the eval "
+            "argument would be shared by all threads, which is not "
+            "supported. Path-dependent evaluators and tasks with axioms are "
+            "not supported either.");
+        document_note(
+            "Time limit",
+            "The max_time option limits the CPU time of the whole process, "
+            "summed over all threads.");
+    }
+
+    virtual shared_ptr<parallel_eager_search::ParallelEagerSearch> create_component(const plugins::Options &options, const utils::Context &) const override {
+        plugins::Options options_copy(options);
+        options_copy.set("reopen_closed", true);
+        return make_shared<parallel_eager_search::ParallelEagerSearch>(options_copy);
+    }
+};
+
+static plugins::FeaturePlugin<ParallelAStarSearchFeature> _plugin;
+}
@@ -0,0 +1,57 @@
+#include "parallel_eager_search.h"
+
+#include "../parser/decorated_abstract_syntax_tree.h"
+#include "../plugins/plugin.h"
+
+using namespace std;
+
+namespace plugin_parallel_eager_greedy {
+class ParallelEagerGreedySearchFeature : public plugins::TypedFeature<SearchEngine, parallel_eager_search::ParallelEagerSearch> {
+public:
+    ParallelEagerGreedySearchFeature() : TypedFeature("parallel_eager_greedy") {
+        document_title("Parallel greedy search (eager)");
+        document_synopsis(
+            "Hash-distributed greedy best-first search: the states are "
+            "partitioned over worker threads by their hash values. Each "
+            "worker runs eager greedy search on its partition and sends "
+            "generated states to their owners. The search stops as soon as "
+            "a worker expands a goal state.");
+
+        add_list_option<shared_ptr<Evaluator>>(
+            "evals", "evaluators", "", true);
+        parallel_eager_search::add_options_to_feature(*this);
+
+        document_note(
+            "Open list",
+            "Every worker uses an alternation open list with one queue for "
+            "each evaluator, or a standard open list if only one evaluator "
+            "is given. Preferred operators are not supported.");
+        document_note(
+            "Closed nodes",
+            "Closed node are not re-opened");
+        document_note(
+            "Evaluator instances",
+            "The evaluators are constructed once per thread. Evaluators that "
+            "are defined with let (or --evaluator) outside of the evals "
+            "argument would be shared by all threads, which is not "
+            "supported. Path-dependent evaluators and tasks with axioms are "
+            "not supported either.");
+        document_note(
+            "Time limit",
+            "The max_time option limits the CPU time of the whole process, "
+            "summed over all threads.");
+    }
+
+    virtual shared_ptr<parallel_eager_search::ParallelEagerSearch> create_component(const plugins::Options &options, const utils::Context &context) const override {
+        parser::LazyValue evals = options.get<parser::LazyValue>("evals");
+        if (evals.construct_lazy_list().empty()) {
+            context.error("List argument 'evals' has to be non-empty.");
+        }
+        plugins::Options options_copy(options);
+        options_copy.set("reopen_closed", false);
+        return make_shared<parallel_eager_search::ParallelEagerSearch>(options_copy);
+    }
+};
+
+static plugins::FeaturePlugin<ParallelEagerGreedySearchFeature> _plugin;
+}
@@ -7,6 +7,11 @@
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+/*
+  The g value using real operator costs is not stored here because it
+  equals g for most search configurations. If it differs, the SearchSpace
+  stores it separately (see SearchSpace::real_g_values).
+*/
 struct SearchNodeInfo {
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
@@ -14,11 +19,10 @@ struct SearchNodeInfo {
     int g : 30;
     StateID parent_state_id;
     OperatorID creating_operator;
-    int real_g;
 
     SearchNodeInfo()
         : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+          creating_operator(-1) {
     }
 };
 
@@ -5,13 +5,14 @@
 
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/memory.h"
 
 #include <cassert>
 
 using namespace std;
 
-SearchNode::SearchNode(const State &state, SearchNodeInfo &info)
-    : state(state), info(info) {
+SearchNode::SearchNode(const State &state, SearchNodeInfo &info, int *real_g)
+    : state(state), info(info), real_g(real_g) {
     assert(state.get_id() != StateID::no_state);
 }
 
@@ -41,14 +42,16 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return real_g ? *real_g : info.g;
 }
 
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
+    if (real_g) {
+        *real_g = 0;
+    }
     info.parent_state_id = StateID::no_state;
     info.creating_operator = OperatorID::no_operator;
 }
@@ -59,7 +62,11 @@ void SearchNode::open(const SearchNode &parent_node,
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
+    if (real_g) {
+        *real_g = parent_node.get_real_g() + parent_op.get_cost();
+    } else {
+        assert(adjusted_cost == parent_op.get_cost());
+    }
     info.parent_state_id = parent_node.get_state().get_id();
     info.creating_operator = OperatorID(parent_op.get_id());
 }
@@ -74,7 +81,11 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
     info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
+    if (real_g) {
+        *real_g = parent_node.get_real_g() + parent_op.get_cost();
+    } else {
+        assert(adjusted_cost == parent_op.get_cost());
+    }
     info.parent_state_id = parent_node.get_state().get_id();
     info.creating_operator = OperatorID(parent_op.get_id());
 }
@@ -88,7 +99,11 @@ void SearchNode::update_parent(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
+    if (real_g) {
+        *real_g = parent_node.get_real_g() + parent_op.get_cost();
+    } else {
+        assert(adjusted_cost == parent_op.get_cost());
+    }
     info.parent_state_id = parent_node.get_state().get_id();
     info.creating_operator = OperatorID(parent_op.get_id());
 }
@@ -117,12 +132,29 @@ void SearchNode::dump(const TaskProxy &task_proxy, utils::LogProxy &log) const {
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
+static bool adjusted_costs_are_real_costs(
+    const TaskProxy &task_proxy, OperatorCost cost_type) {
+    bool is_unit_cost = task_properties::is_unit_cost(task_proxy);
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (get_adjusted_action_cost(op, cost_type, is_unit_cost) != op.get_cost()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SearchSpace::SearchSpace(
+    StateRegistry &state_registry, OperatorCost cost_type,
+    utils::LogProxy &log)
     : state_registry(state_registry), log(log) {
+    if (!adjusted_costs_are_real_costs(state_registry.get_task_proxy(), cost_type)) {
+        real_g_values = utils::make_unique_ptr<PerStateInformation<int>>(-1);
+    }
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
-    return SearchNode(state, search_node_infos[state]);
+    int *real_g = real_g_values ? &(*real_g_values)[state] : nullptr;
+    return SearchNode(state, search_node_infos[state], real_g);
 }
 
 void SearchSpace::trace_path(const State &goal_state,
@@ -164,4 +196,9 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
 
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics(log);
+    int bytes_per_node = sizeof(SearchNodeInfo);
+    if (real_g_values) {
+        bytes_per_node += sizeof(int);
+    }
+    log << "Bytes per search node: " << bytes_per_node << endl;
 }
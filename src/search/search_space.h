@@ -5,6 +5,7 @@
 #include "per_state_information.h"
 #include "search_node_info.h"
 
+#include <memory>
 #include <vector>
 
 class OperatorProxy;
@@ -18,8 +19,10 @@ class LogProxy;
 class SearchNode {
     State state;
     SearchNodeInfo &info;
+    // Points to the g value using real costs or is nullptr if it equals g.
+    int *real_g;
 public:
-    SearchNode(const State &state, SearchNodeInfo &info);
+    SearchNode(const State &state, SearchNodeInfo &info, int *real_g);
 
     const State &get_state() const;
 
@@ -50,11 +53,18 @@ public:
 
 class SearchSpace {
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    /*
+      g values using real operator costs. They are only stored if they
+      can differ from the g values using adjusted costs, i.e., if the
+      adjusted cost of some operator differs from its real cost.
+    */
+    std::unique_ptr<PerStateInformation<int>> real_g_values;
 
     StateRegistry &state_registry;
     utils::LogProxy &log;
 public:
-    SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
+    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                utils::LogProxy &log);
 
     SearchNode get_node(const State &state);
     void trace_path(const State &goal_state,
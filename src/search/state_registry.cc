@@ -5,9 +5,71 @@
 
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/language.h"
+
+#include <algorithm>
 
 using namespace std;
 
+template<int StateSize>
+static int_hash_set::HashType hash_state_data(
+    const PackedStateBin *data, int state_size) {
+    assert(state_size == StateSize);
+    utils::unused_variable(state_size);
+    utils::HashState hash_state;
+    hash_state.feed_values(data, StateSize);
+    return hash_state.get_hash32();
+}
+
+template<int StateSize>
+static bool equal_state_data(
+    const PackedStateBin *lhs, const PackedStateBin *rhs, int state_size) {
+    assert(state_size == StateSize);
+    utils::unused_variable(state_size);
+    /* The hash set only compares states with equal hashes, which are
+       almost always equal, so we compare all bins without branching. */
+    PackedStateBin difference = 0;
+    for (int i = 0; i < StateSize; ++i) {
+        difference |= lhs[i] ^ rhs[i];
+    }
+    return difference == 0;
+}
+
+static bool equal_state_data_generic(
+    const PackedStateBin *lhs, const PackedStateBin *rhs, int state_size) {
+    return equal(lhs, lhs + state_size, rhs);
+}
+
+StateDataHashFunction StateRegistry::get_state_data_hash_function(
+    int state_size) {
+    switch (state_size) {
+    case 1: return hash_state_data<1>;
+    case 2: return hash_state_data<2>;
+    case 3: return hash_state_data<3>;
+    case 4: return hash_state_data<4>;
+    case 5: return hash_state_data<5>;
+    case 6: return hash_state_data<6>;
+    case 7: return hash_state_data<7>;
+    case 8: return hash_state_data<8>;
+    default: return get_state_data_hash;
+    }
+}
+
+StateDataEqualFunction StateRegistry::get_state_data_equal_function(
+    int state_size) {
+    switch (state_size) {
+    case 1: return equal_state_data<1>;
+    case 2: return equal_state_data<2>;
+    case 3: return equal_state_data<3>;
+    case 4: return equal_state_data<4>;
+    case 5: return equal_state_data<5>;
+    case 6: return equal_state_data<6>;
+    case 7: return equal_state_data<7>;
+    case 8: return equal_state_data<8>;
+    default: return equal_state_data_generic;
+    }
+}
+
 StateRegistry::StateRegistry(const TaskProxy &task_proxy)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
@@ -64,25 +126,43 @@ const State &StateRegistry::get_initial_state() {
 //     operating on state buffers (PackedStateBin *).
 State StateRegistry::get_successor_state(const State &predecessor, const OperatorProxy &op) {
     assert(!op.is_axiom());
+    /*
+      The successor is written to the end of the state data pool and removed
+      again by insert_id_or_pop_state if it is a duplicate. Removing it does
+      not free memory, so generating duplicates does not allocate.
+    */
+    StateID new_state_id(state_data_pool.size());
     state_data_pool.push_back(predecessor.get_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
     /* Experiments for issue348 showed that for tasks with axioms it's faster
        to compute successor states using unpacked data. */
     if (task_properties::has_axioms(task_proxy)) {
         predecessor.unpack();
-        vector<int> new_values = predecessor.get_unpacked_values();
+        successor_values = predecessor.get_unpacked_values();
+        changed_vars.clear();
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
                 FactPair effect_pair = effect.get_fact().get_pair();
-                new_values[effect_pair.var] = effect_pair.value;
+                if (successor_values[effect_pair.var] != effect_pair.value) {
+                    successor_values[effect_pair.var] = effect_pair.value;
+                    changed_vars.push_back(effect_pair.var);
+                }
             }
         }
-        axiom_evaluator.evaluate(new_values);
-        for (size_t i = 0; i < new_values.size(); ++i) {
-            state_packer.set(buffer, i, new_values[i]);
+        /* Registered states have correct values for their derived
+           variables, so we only need to update the affected ones. */
+        axiom_evaluator.evaluate_incrementally(successor_values, changed_vars);
+        for (size_t i = 0; i < successor_values.size(); ++i) {
+            state_packer.set(buffer, i, successor_values[i]);
         }
         StateID id = insert_id_or_pop_state();
-        return task_proxy.create_state(*this, id, buffer, move(new_values));
+        if (id != new_state_id) {
+            return lookup_state(id);
+        }
+        /* New states keep a copy of their unpacked values because they
+           are usually evaluated next. */
+        return task_proxy.create_state(
+            *this, id, buffer, vector<int>(successor_values));
     } else {
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
@@ -95,6 +175,39 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
     }
 }
 
+void StateRegistry::compute_successor_data(
+    const State &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) const {
+    assert(!op.is_axiom());
+    assert(!task_properties::has_axioms(task_proxy));
+    const PackedStateBin *predecessor_buffer = predecessor.get_buffer();
+    copy(predecessor_buffer, predecessor_buffer + get_bins_per_state(), buffer);
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, predecessor)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            state_packer.set(buffer, effect_pair.var, effect_pair.value);
+        }
+    }
+}
+
+State StateRegistry::register_state_data(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+StateID StateRegistry::find_state_id(const PackedStateBin *buffer) {
+    /* The hash set only compares state IDs, so we temporarily add the
+       data to the state data pool. */
+    state_data_pool.push_back(buffer);
+    int id = registered_states.find(state_data_pool.size() - 1);
+    state_data_pool.pop_back();
+    if (id == -1) {
+        return StateID::no_state;
+    }
+    return StateID(id);
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
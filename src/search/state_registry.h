@@ -11,6 +11,7 @@
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
 
+#include <cstdint>
 #include <set>
 
 /*
@@ -110,43 +111,47 @@ class IntPacker;
 }
 
 using PackedStateBin = int_packer::IntPacker::Bin;
+static_assert(sizeof(PackedStateBin) == sizeof(std::uint32_t),
+              "Packed states are hashed as sequences of 32-bit values.");
+
+using StateDataHashFunction = int_hash_set::HashType (*)(
+    const PackedStateBin *data, int state_size);
+using StateDataEqualFunction = bool (*)(
+    const PackedStateBin *lhs, const PackedStateBin *rhs, int state_size);
 
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
         const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
+        StateDataHashFunction hash;
         StateIDSemanticHash(
             const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
-              state_size(state_size) {
+              state_size(state_size),
+              hash(get_state_data_hash_function(state_size)) {
         }
 
         int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+            return hash(state_data_pool[id], state_size);
         }
     };
 
     struct StateIDSemanticEqual {
         const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
+        StateDataEqualFunction equal;
         StateIDSemanticEqual(
             const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
-              state_size(state_size) {
+              state_size(state_size),
+              equal(get_state_data_equal_function(state_size)) {
         }
 
         bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
-            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+            return equal(state_data_pool[lhs], state_data_pool[rhs], state_size);
         }
     };
 
@@ -167,11 +172,35 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
 
     std::unique_ptr<State> cached_initial_state;
 
+    // Reused for computing the unpacked values of successor states.
+    std::vector<int> successor_values;
+    std::vector<int> changed_vars;
+
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
 public:
     explicit StateRegistry(const TaskProxy &task_proxy);
 
+    /*
+      Hash of packed state data as used for duplicate detection. Registries
+      for the same task hash equal states to the same value.
+    */
+    static int_hash_set::HashType get_state_data_hash(
+        const PackedStateBin *data, int state_size) {
+        utils::HashState hash_state;
+        hash_state.feed_values(data, state_size);
+        return hash_state.get_hash32();
+    }
+
+    /*
+      Return functions that compute the same hash as get_state_data_hash
+      and compare packed state data, respectively, for states of the given
+      size. For small states, they are instantiated for the exact number of
+      bins, so that the compiler can unroll and vectorize their loops.
+      Select them once and reuse them for all states of the task.
+    */
+    static StateDataHashFunction get_state_data_hash_function(int state_size);
+    static StateDataEqualFunction get_state_data_equal_function(int state_size);
+
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
     }
@@ -203,6 +232,44 @@ public:
     */
     State get_successor_state(const State &predecessor, const OperatorProxy &op);
 
+    /*
+      Writes the packed data of the state that results from applying op to
+      predecessor into buffer, which must hold get_bins_per_state() bins.
+      Unlike get_successor_state, this neither registers the successor nor
+      modifies the registry, so it may be called concurrently. Only
+      supported for tasks without axioms.
+    */
+    void compute_successor_data(const State &predecessor, const OperatorProxy &op,
+                                PackedStateBin *buffer) const;
+
+    /*
+      Returns the state with the given packed data (e.g., computed by
+      compute_successor_data of another registry for the same task) and
+      registers it if this was not done before. The data is copied.
+    */
+    State register_state_data(const PackedStateBin *buffer);
+
+    /*
+      Returns the ID of the state with the given packed data, or
+      StateID::no_state if it is not registered. Unlike
+      register_state_data, this never registers the state. Note that it
+      temporarily writes the data to the end of the state data pool, which
+      invalidates states that get_successor_state returned for states that
+      were already registered.
+    */
+    StateID find_state_id(const PackedStateBin *buffer);
+
+    /*
+      Returns the hash of the given packed state data that this registry uses
+      for duplicate detection. Equal states have equal hashes in all
+      registries of the same task.
+    */
+    int_hash_set::HashType get_hash(const PackedStateBin *buffer) const {
+        return get_state_data_hash(buffer, get_bins_per_state());
+    }
+
+    int get_bins_per_state() const;
+
     /*
       Returns the number of states registered so far.
     */
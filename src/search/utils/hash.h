@@ -170,6 +170,37 @@ public:
         }
     }
 
+    /*
+      Feed a sequence of values. The resulting hash is the same as for
+      feeding the values one by one, but if no values are pending, full
+      triples are added without dispatching on pending_values for every
+      value, which lets the compiler unroll the loop if num_values is a
+      compile-time constant.
+    */
+    void feed_values(const std::uint32_t *values, std::size_t num_values) {
+        assert(pending_values != -1);
+        if (pending_values != 0 && pending_values != 3) {
+            for (std::size_t i = 0; i < num_values; ++i) {
+                feed(values[i]);
+            }
+            return;
+        }
+        std::size_t num_triples = num_values / 3;
+        for (std::size_t i = 0; i < num_triples; ++i) {
+            if (pending_values == 3) {
+                mix();
+            }
+            a += values[3 * i];
+            b += values[3 * i + 1];
+            c += values[3 * i + 2];
+            pending_values = 3;
+        }
+        const std::uint32_t *remaining_values = values + 3 * num_triples;
+        for (std::size_t i = 0; i < num_values % 3; ++i) {
+            feed(remaining_values[i]);
+        }
+    }
+
     /*
       After calling this method, it is illegal to use the HashState object
       further, i.e., make further calls to feed, get_hash32 or get_hash64. We
@@ -0,0 +1,79 @@
+#ifndef UTILS_MPSC_QUEUE_H
+#define UTILS_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace utils {
+/*
+  Unbounded lock-free queue with many producers and a single consumer
+  (Vyukov's node-based MPSC queue). Any thread may call push concurrently,
+  but only the thread owning the queue may call pop and empty.
+
+  A push that is still in progress can be invisible to the consumer for a
+  short while, i.e., pop may fail although a concurrent push has already
+  started. Users that must know whether messages are in flight (e.g., for
+  termination detection) have to count them separately.
+
+  T must be default-constructible and movable.
+*/
+template<typename T>
+class MPSCQueue {
+    struct Node {
+        std::atomic<Node *> next;
+        T value;
+
+        Node()
+            : next(nullptr) {
+        }
+
+        explicit Node(T &&value)
+            : next(nullptr), value(std::move(value)) {
+        }
+    };
+
+    // Producers append after head; keep it apart from the consumer's tail.
+    alignas(64) std::atomic<Node *> head;
+    alignas(64) Node *tail;
+
+public:
+    MPSCQueue()
+        : head(new Node()) {
+        tail = head.load(std::memory_order_relaxed);
+    }
+
+    ~MPSCQueue() {
+        while (tail) {
+            Node *next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    void push(T &&value) {
+        Node *node = new Node(std::move(value));
+        Node *previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T &value) {
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    bool empty() const {
+        return tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+void parallel_for(
+    int num_items, int num_threads, const function<void(int, int)> &func) {
+    int num_workers = min(num_threads, num_items);
+    if (num_workers <= 1) {
+        for (int index = 0; index < num_items; ++index) {
+            func(0, index);
+        }
+        return;
+    }
+
+    atomic<int> next_index(0);
+    auto work = [&](int worker_id) {
+            for (int index = next_index++; index < num_items;
+                 index = next_index++) {
+                func(worker_id, index);
+            }
+        };
+    vector<thread> threads;
+    threads.reserve(num_workers - 1);
+    for (int worker_id = 1; worker_id < num_workers; ++worker_id) {
+        threads.emplace_back(work, worker_id);
+    }
+    work(0);
+    for (thread &t : threads) {
+        t.join();
+    }
+}
+}
@@ -0,0 +1,20 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+
+namespace utils {
+/*
+  Call func(worker_id, index) for every index in [0, num_items) on up to
+  num_threads threads, where worker_id in [0, num_threads) identifies the
+  calling thread. Indices are handed out dynamically, so the mapping of
+  indices to workers is not deterministic: func must only write to data
+  owned by its index or its worker. The calling thread acts as worker 0,
+  and everything runs sequentially on it if num_threads <= 1.
+*/
+extern void parallel_for(
+    int num_items, int num_threads,
+    const std::function<void(int, int)> &func);
+}
+
+#endif